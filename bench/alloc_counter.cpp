@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stddef.h>
+#include <limits.h>
+#include <errno.h>
+#include <atomic>
+
+#include "alloc_counter.h"
+
+static std::atomic<uint64_t> alloc_count(0);
+static std::atomic<uint64_t> alloc_bytes(0);
+
+static inline void count_alloc(size_t size) {
+    alloc_count.fetch_add(1, std::memory_order_relaxed);
+    alloc_bytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+#ifdef __GLIBC__
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+
+//the executable defines them first, so every library of the process calls these ones
+void* malloc(size_t size) {
+    count_alloc(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size) {
+    count_alloc(n*size);
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    count_alloc(size);
+    return __libc_realloc(ptr, size);
+}
+
+//cv::fastMalloc goes through posix_memalign
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    if (alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0)
+        return EINVAL;
+    count_alloc(size);
+    void* p = __libc_memalign(alignment, size);
+    if (!p && size)
+        return ENOMEM;
+    *ptr = p;
+    return 0;
+}
+
+void* memalign(size_t alignment, size_t size) {
+    count_alloc(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    count_alloc(size);
+    return __libc_memalign(alignment, size);
+}
+
+}
+#endif
+
+alloc_stats alloc_snapshot() {
+    alloc_stats stats;
+    stats.count = alloc_count.load(std::memory_order_relaxed);
+    stats.bytes = alloc_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+bool alloc_counting() {
+#ifdef __GLIBC__
+    return true;
+#else
+    return false;
+#endif
+}
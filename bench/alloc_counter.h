@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_ALLOC_COUNTER_H_
+#define _TRACKIMG_ALLOC_COUNTER_H_
+
+#include <stdint.h>
+
+/* heap allocations since the start of the process, all threads included */
+struct alloc_stats
+{
+    uint64_t count;
+    uint64_t bytes;
+};
+
+/*
+ * The benchmark replaces malloc, calloc, realloc and the aligned
+ * allocators (posix_memalign, memalign, aligned_alloc), which serve
+ * operator new and cv::fastMalloc, to count the allocations of the
+ * measured calls. Only available with glibc, the counts stay at 0
+ * otherwise.
+ */
+alloc_stats alloc_snapshot();
+bool alloc_counting();
+
+#endif  /* _TRACKIMG_ALLOC_COUNTER_H_ */
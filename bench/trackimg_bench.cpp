@@ -0,0 +1,446 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <unistd.h>
+#include "opencv2/core/core.hpp"
+#include <omp.h>
+
+#include "trackimg.h"
+#include "trace.h"
+#include "options.h"
+#include "tracker.h"
+#include "target.h"
+#include "frame.h"
+#include "lars.h"
+#include "projection.h"
+#include "linalg.h"
+#include "alloc_counter.h"
+
+using namespace std;
+using namespace cv;
+
+static const char* lars_solver_names[LARS_SOLVER_SIZE] = {
+    "lu",
+    "chol",
+    "gram"
+};
+
+static const char *usage =
+    "Trackimg benchmark\n"
+
+    "\nUsage: trackimg_bench [options]\n"
+
+    "\nDescription:\n"
+    "Latency and allocations of the hot paths of the tracker on synthetic\n"
+    "inputs drawn from a seeded generator.\n"
+
+    "\nOptional parameters:\n"
+    "-a <backends>      Comma separated matrix product backends to sweep,\n"
+    "                   0 opencv, 1 blocked (fallback), 2 eigen, 3 blas.\n"
+    "                   {Default : the TRACKIMG_LINALG of the build}\n"
+    "-c <case>          Case to run: gemm, lars, lasso, windows, negative,\n"
+    "                   frame or all. {Default : all}\n"
+    "-f <bits>          Floating point precision, 32 or 64. {Default : 32}\n"
+    "-i <iterations>    Measured calls per configuration. {Default : 50}\n"
+    "-l <solver>        LARS solver of lars, lasso and frame: 0 lu, 1 chol,\n"
+    "                   2 gram. {Default : 2}\n"
+    "-r <projection>    Random projection of lasso and frame. {Default : 0}\n"
+    "-s <seed>          Seed of the inputs and projections. {Default : 1}\n"
+    "-t <threads>       Comma separated thread counts to sweep, for scaling\n"
+    "                   curves. {Default : OpenMP default}\n"
+    "-w <warmup>        Unmeasured calls per configuration. {Default : 5}\n"
+    "-h                 Print this message.\n";
+
+struct bench_config
+{
+    string name;
+    int iterations;
+    int warmup;
+    unsigned int seed;
+    int solver;
+    int projection;
+    vector<int> threads;
+    vector<int> backends;
+};
+
+static double percentile(const vector<double>& sorted, double p) {
+    int i = (int)ceil(p*sorted.size()) - 1;
+    return sorted[std::max(0, std::min(i, (int)sorted.size()-1))];
+}
+
+/**
+ * Time <call> for every thread count of the configuration, after the
+ * warmup calls, and print one line per thread count. The inputs are built
+ * by the caller, only the calls are measured.
+ */
+template<typename _Call>
+static void bench_case(const bench_config& cfg, const char* name, string params, _Call call) {
+    for (size_t t=0; t<cfg.threads.size(); t++) {
+        omp_set_num_threads(cfg.threads[t]);
+        theRNG() = RNG(cfg.seed);
+        for (int i=0; i<cfg.warmup; i++) {
+            call();
+        }
+        vector<double> times(cfg.iterations);
+        alloc_stats before = alloc_snapshot();
+        for (int i=0; i<cfg.iterations; i++) {
+            double start_time = omp_get_wtime();
+            call();
+            times[i] = (omp_get_wtime() - start_time)*1e6;
+        }
+        alloc_stats after = alloc_snapshot();
+        sort(times.begin(), times.end());
+        printf("%-10s %-28s %7d %-8s %12.1f %12.1f %12.1f %10.1f %12.0f\n", name, params.c_str(), cfg.threads[t], linalg_name(linalg_backend()),
+               percentile(times, 0.5), percentile(times, 0.95), percentile(times, 0.99),
+               (double)(after.count-before.count)/cfg.iterations, (double)(after.bytes-before.bytes)/cfg.iterations);
+        fflush(stdout);
+    }
+}
+
+static string format_params(const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    return buffer;
+}
+
+/* 8-bit frame of uniform noise with a brighter object at box, so that it can be found */
+static Mat synthetic_frame(RNG& rng, int rows, int cols, Rect box) {
+    Mat frame(rows, cols, CV_8UC3);
+    rng.fill(frame, RNG::UNIFORM, 0, 128);
+    Mat object = frame(box);
+    rng.fill(object, RNG::UNIFORM, 128, 255);
+    return frame;
+}
+
+/* rows*cols matrix of N(0,1) with rows of unit norm */
+template<typename _Tp>
+static Mat synthetic_atoms(RNG& rng, int rows, int cols) {
+    Mat atoms(rows, cols, TRACKIMG_TYPE(_Tp,1));
+    rng.fill(atoms, RNG::NORMAL, 0, 1);
+    for (int i=0; i<rows; i++) {
+        Mat atom = atoms.row(i);
+        atom *= 1/norm(atom);
+    }
+    return atoms;
+}
+
+template<typename _Tp>
+static void bench_lars(const bench_config& cfg) {
+    const int ms[] = { 64, 128, 256 };
+    const int ns[] = { 128, 512, 2048 };
+    const int nus[] = { 10, 20 };
+    for (int im=0; im<3; im++) {
+        for (int in=0; in<3; in++) {
+            for (int inu=0; inu<2; inu++) {
+                RNG rng(cfg.seed);
+                //one atom per column, as after the projection
+                Mat X = synthetic_atoms<_Tp>(rng, ns[in], ms[im]).t();
+                Mat y = synthetic_atoms<_Tp>(rng, 1, ms[im]).t();
+                //the Gram solver reads X'*X and X'*y, shared by all the windows in the tracker
+                Mat G, b;
+                if (cfg.solver == LARS_SOLVER_GRAM) {
+                    linalg_gemm<_Tp>(X, X, G, GEMM_1_T);
+                    linalg_gemm<_Tp>(X, y, b, GEMM_1_T);
+                }
+                double yy = y.dot(y);
+                bench_case(cfg, "lars", format_params("%s m=%d n=%d nu=%d", lars_solver_names[cfg.solver], ms[im], ns[in], nus[inu]), [&]() {
+                    switch (cfg.solver) {
+                    case LARS_SOLVER_REFERENCE:
+                        lars_lu<_Tp>(y, X, 0.001, nus[inu]);
+                        break;
+                    case LARS_SOLVER_CHOLESKY:
+                        lars_chol<_Tp>(y, X, 0.001, nus[inu]);
+                        break;
+                    default:
+                        lars_gram<_Tp>(G, b, yy, 0.001, nus[inu]);
+                        break;
+                    }
+                });
+            }
+        }
+    }
+}
+
+template<typename _Tp>
+static void bench_lasso(const bench_config& cfg) {
+    //22 templates of a 41*30 RGB object against the windows of a 2x region
+    const int dim = 41*30*3;
+    const double crs[] = { 10, 30 };
+    const double itrs[] = { 1, 3 };
+    RNG rng(cfg.seed);
+    Mat T = synthetic_atoms<_Tp>(rng, 22, dim);
+    Mat D = synthetic_atoms<_Tp>(rng, 400, dim);
+    parameter_OMP param;
+    param.err = 0.001;
+    param.nu = 20;
+    param.solver = cfg.solver;
+    param.projection = cfg.projection;
+    param.seed = cfg.seed;
+    for (int ic=0; ic<2; ic++) {
+        for (int ii=0; ii<2; ii++) {
+            bench_case(cfg, "Rec_Lasso", format_params("cr=%g itr=%g n=%d", crs[ic], itrs[ii], D.rows), [&]() {
+                //Rec_Lasso normalizes T in place
+                Rec_Lasso<_Tp>(T.clone(), D, Mat(), crs[ic], itrs[ii], param);
+            });
+        }
+    }
+}
+
+template<typename _Tp>
+static void bench_windows(const bench_config& cfg) {
+    const Size objects[] = { Size(41, 30), Size(80, 60) };
+    const int scales[] = { 2, 3 };
+    for (int io=0; io<2; io++) {
+        for (int is=0; is<2; is++) {
+            RNG rng(cfg.seed);
+            Mat A(objects[io].height*scales[is], objects[io].width*scales[is], TRACKIMG_TYPE(_Tp,3));
+            rng.fill(A, RNG::UNIFORM, 0, 255);
+            bench_case(cfg, "windows", format_params("obj=%dx%d region=x%d", objects[io].width, objects[io].height, scales[is]), [&]() {
+                vector<window_index> idx;
+                Mat D = im_seg_windows<_Tp>(A, objects[io].height, objects[io].width, 4, 4, idx);
+                window_norms<_Tp>(A, idx, 4, 4);
+            });
+        }
+    }
+}
+
+template<typename _Tp>
+static void bench_negative(const bench_config& cfg) {
+    const int scales[] = { 2, 3 };
+    RNG rng(cfg.seed);
+    Rect box(140, 105, 41, 30);
+    Mat frame_c = synthetic_frame(rng, 240, 320, box);
+    frame_context<_Tp> frame;
+    Mat p(2, 1, CV_64F);
+    p.at<double>(0,0) = box.x;
+    p.at<double>(1,0) = box.y;
+    Mat sz(2, 1, CV_64F);
+    sz.at<double>(0,0) = box.width;
+    sz.at<double>(1,0) = box.height;
+    for (int is=0; is<2; is++) {
+        Mat sr = Mat::ones(2, 1, CV_64F)*scales[is];
+        bench_case(cfg, "negative", format_params("frame=320x240 region=x%d", scales[is]), [&]() {
+            //a new frame every call, its region is converted each time
+            frame.reset(frame_c);
+            Region_Negative<_Tp>(frame, 10, 10, p, sz, sr, rng);
+        });
+    }
+}
+
+template<typename _Tp>
+static void bench_frame(const bench_config& cfg) {
+    options opt;
+    opt.setLarsSolver(cfg.solver);
+    opt.setProjection(cfg.projection);
+    opt.setSeed(cfg.seed);
+    RNG rng(cfg.seed);
+    Rect box(140, 105, 41, 30);
+    Mat a = synthetic_frame(rng, 240, 320, box);
+    //the object moved by a few pixels in the tracked frame
+    Mat b = synthetic_frame(rng, 240, 320, box + Point(3, 2));
+    target_tracker<_Tp> target(opt, 0);
+    frame_context<_Tp> frame;
+    frame.reset(a);
+    target.init(frame, box);
+    int k = 0;
+    bench_case(cfg, "frame", "frame=320x240 obj=41x30", [&]() {
+        frame.reset(b);
+        target.track(frame, ++k);
+    });
+}
+
+/* the products of the solver: projection of the dictionary, correlations and Gram matrix */
+template<typename _Tp>
+static void bench_gemm(const bench_config& cfg) {
+    RNG rng(cfg.seed);
+    Mat P = synthetic_atoms<_Tp>(rng, 123, 3690);
+    Mat D = synthetic_atoms<_Tp>(rng, 400, 3690);
+    Mat X = synthetic_atoms<_Tp>(rng, 400, 123).t();
+    Mat r = synthetic_atoms<_Tp>(rng, 1, 123).t();
+    Mat C;
+    bench_case(cfg, "gemm", "P*D' 123x3690 400x3690", [&]() {
+        linalg_gemm<_Tp>(P, D, C, GEMM_2_T);
+    });
+    bench_case(cfg, "gemm", "X'*r 123x400 123x1", [&]() {
+        linalg_gemm<_Tp>(X, r, C, GEMM_1_T);
+    });
+    bench_case(cfg, "gemm", "X'*X 123x400 123x400", [&]() {
+        linalg_gemm<_Tp>(X, X, C, GEMM_1_T);
+    });
+}
+
+template<typename _Tp>
+static void bench_cases(const bench_config& cfg) {
+    if (cfg.name == "all" || cfg.name == "gemm") {
+        bench_gemm<_Tp>(cfg);
+    }
+    if (cfg.name == "all" || cfg.name == "lars") {
+        bench_lars<_Tp>(cfg);
+    }
+    if (cfg.name == "all" || cfg.name == "lasso") {
+        bench_lasso<_Tp>(cfg);
+    }
+    if (cfg.name == "all" || cfg.name == "windows") {
+        bench_windows<_Tp>(cfg);
+    }
+    if (cfg.name == "all" || cfg.name == "negative") {
+        bench_negative<_Tp>(cfg);
+    }
+    if (cfg.name == "all" || cfg.name == "frame") {
+        bench_frame<_Tp>(cfg);
+    }
+}
+
+template<typename _Tp>
+static void bench(const bench_config& cfg) {
+    printf("%-10s %-28s %7s %-8s %12s %12s %12s %10s %12s\n", "case", "params", "threads", "linalg", "median_us", "p95_us", "p99_us", "allocs", "bytes");
+    for (size_t b=0; b<cfg.backends.size(); b++) {
+        linalg_set_backend(cfg.backends[b]);
+        bench_cases<_Tp>(cfg);
+    }
+}
+
+void print_usage_bench() {
+    printf("%s", usage);
+    fflush(stdout);
+}
+
+int main(int argc, char **argv) {
+    int c;
+    const char *ostr = "a:c:f:i:l:r:s:t:w:h";
+
+    bench_config cfg;
+    cfg.name = "all";
+    cfg.iterations = 50;
+    cfg.warmup = 5;
+    cfg.seed = 1;
+    cfg.solver = LARS_SOLVER_GRAM;
+    cfg.projection = PROJECTION_GAUSSIAN;
+    int precision = 32;
+
+    while ((c = getopt(argc, argv, ostr)) != -1) {
+        switch (c) {
+        case 'a': {
+            istringstream list(optarg);
+            string backend;
+            while (getline(list, backend, ',')) {
+                cfg.backends.push_back(atoi(backend.c_str()));
+            }
+            break;
+        }
+        case 'c':
+            cfg.name = optarg;
+            break;
+        case 'f':
+            precision = atoi(optarg);
+            break;
+        case 'i':
+            cfg.iterations = atoi(optarg);
+            break;
+        case 'l':
+            cfg.solver = atoi(optarg);
+            break;
+        case 'r':
+            cfg.projection = atoi(optarg);
+            break;
+        case 's':
+            cfg.seed = strtoul(optarg, NULL, 10);
+            break;
+        case 't': {
+            istringstream list(optarg);
+            string count;
+            while (getline(list, count, ',')) {
+                cfg.threads.push_back(atoi(count.c_str()));
+            }
+            break;
+        }
+        case 'w':
+            cfg.warmup = atoi(optarg);
+            break;
+        case 'h':
+            print_usage_bench();
+            exit(TRACKIMG_OK);
+        default:
+            print_trackimg_error(TRACKIMG_ERR_BAD_ARGS);
+            print_usage_bench();
+            exit(TRACKIMG_ERR_BAD_ARGS);
+        }
+    }
+    if (cfg.threads.empty()) {
+        cfg.threads.push_back(omp_get_max_threads());
+    }
+    if (cfg.backends.empty()) {
+        cfg.backends.push_back(linalg_backend());
+    }
+    for (size_t b=0; b<cfg.backends.size(); b++) {
+        if (!linalg_available(cfg.backends[b])) {
+            print_trackimg_error(TRACKIMG_ERR_BAD_ARGS);
+            printf("Matrix product backend %d is not built in\n", cfg.backends[b]);
+            print_usage_bench();
+            exit(TRACKIMG_ERR_BAD_ARGS);
+        }
+    }
+    for (size_t t=0; t<cfg.threads.size(); t++) {
+        if (cfg.threads[t] < 1) {
+            print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_NBPROC);
+            exit(TRACKIMG_ERR_BAD_ARGS_NBPROC);
+        }
+    }
+    if (cfg.iterations < 1 || cfg.warmup < 0 || (precision != 32 && precision != 64)
+            || cfg.solver < 0 || cfg.solver >= LARS_SOLVER_SIZE || cfg.projection < 0 || cfg.projection >= PROJECTION_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS);
+        print_usage_bench();
+        exit(TRACKIMG_ERR_BAD_ARGS);
+    }
+    if (!alloc_counting()) {
+        printf("Allocation counting is not available on this platform, allocs and bytes are 0\n");
+    }
+
+    if (precision == 64) {
+        bench<double>(cfg);
+    } else {
+        bench<float>(cfg);
+    }
+
+    exit (TRACKIMG_OK);
+}
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+#include <glob.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <omp.h>
+
+#include "trackimg.h"
+#include "trace.h"
+#include "batch.h"
+
+static bool valid_box(string box) {
+    int x, y, w, h;
+    char end;
+    return sscanf(box.c_str(), "%d,%d,%d,%d%c", &x, &y, &w, &h, &end) == 4 && x >= 0 && y >= 0 && w > 0 && h > 0;
+}
+
+static double cpu_seconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec*1e-6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec*1e-6;
+}
+
+bool list_batch_sequences(string arg, vector<batch_sequence>& sequences) {
+    batch_sequence seq;
+    seq.status = TRACKIMG_OK;
+    seq.frames = 0;
+    seq.seconds = 0;
+    seq.eval.frames = 0;
+    if (arg.find_first_of("*?[") != string::npos) {
+        glob_t matches;
+        if (glob(arg.c_str(), GLOB_MARK, NULL, &matches) != 0) {
+            return false;
+        }
+        for (size_t i=0; i<matches.gl_pathc; i++) {
+            string path = matches.gl_pathv[i];
+            //GLOB_MARK ends directories with a '/'
+            if (!path.empty() && path[path.size()-1] == '/') {
+                seq.directory = path.substr(0, path.size()-1);
+                sequences.push_back(seq);
+            }
+        }
+        globfree(&matches);
+        return !sequences.empty();
+    }
+    ifstream list(arg.c_str());
+    if (!list.is_open()) {
+        return false;
+    }
+    string line;
+    while (getline(list, line)) {
+        istringstream fields(line);
+        seq.directory.clear();
+        seq.box.clear();
+        fields >> seq.directory >> seq.box;
+        if (seq.directory.empty() || seq.directory[0] == '#') {
+            continue;
+        }
+        if (!seq.box.empty() && !valid_box(seq.box)) {
+            print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_TARGET);
+            return false;
+        }
+        sequences.push_back(seq);
+    }
+    return !sequences.empty();
+}
+
+batch_summary run_batch(vector<batch_sequence>& sequences, int jobs, function<int(batch_sequence&)> track) {
+    batch_summary summary;
+    //the cores are shared by the workers, each one runs its sequence on its part
+    int workers_count = min(jobs, (int)sequences.size());
+    int nb_threads = max(1, omp_get_max_threads()/max(1, workers_count));
+    double start_cpu = cpu_seconds();
+    double start_time = omp_get_wtime();
+
+    atomic<int> next(0);
+    vector<thread> workers;
+    for (int w=0; w<workers_count; w++) {
+        workers.push_back(thread([&]() {
+            //the OpenMP threads of the sequence, the worker is not an OpenMP thread
+            omp_set_num_threads(nb_threads);
+            for (int i=next.fetch_add(1); i<(int)sequences.size(); i=next.fetch_add(1)) {
+                double seq_start = omp_get_wtime();
+                sequences[i].status = track(sequences[i]);
+                sequences[i].seconds = omp_get_wtime() - seq_start;
+            }
+        }));
+    }
+    for (size_t w=0; w<workers.size(); w++) {
+        workers[w].join();
+    }
+
+    summary.seconds = omp_get_wtime() - start_time;
+    summary.cpuSeconds = cpu_seconds() - start_cpu;
+    summary.sequences = sequences.size();
+    summary.failed = 0;
+    summary.frames = 0;
+    summary.eval.frames = 0;
+    summary.eval.meanIou = summary.eval.successAuc = summary.eval.precision = 0;
+    int evaluated = 0;
+    for (size_t i=0; i<sequences.size(); i++) {
+        const batch_sequence& seq = sequences[i];
+        summary.frames += seq.frames;
+        if (seq.status != TRACKIMG_OK) {
+            summary.failed++;
+        }
+        if (seq.eval.frames > 0) {
+            summary.eval.frames += seq.eval.frames;
+            summary.eval.meanIou += seq.eval.meanIou;
+            summary.eval.successAuc += seq.eval.successAuc;
+            summary.eval.precision += seq.eval.precision;
+            evaluated++;
+        }
+    }
+    if (evaluated > 0) {
+        summary.eval.meanIou /= evaluated;
+        summary.eval.successAuc /= evaluated;
+        summary.eval.precision /= evaluated;
+    }
+    summary.eval.fps = summary.seconds > 0 ? summary.frames/summary.seconds : 0;
+    return summary;
+}
+
+bool write_batch_summary(const vector<batch_sequence>& sequences, const batch_summary& summary, string path) {
+    FILE* file = NULL;
+    if (!path.empty()) {
+        file = fopen(path.c_str(), "w");
+        if (file == NULL) {
+            return false;
+        }
+        fprintf(file, "sequence,status,frames,seconds,fps,cpu_seconds,success_auc,precision\n");
+    }
+    printf("Batch results :\n");
+    for (size_t i=0; i<sequences.size(); i++) {
+        const batch_sequence& seq = sequences[i];
+        double fps = seq.seconds > 0 ? seq.frames/seq.seconds : 0;
+        printf("   + %-40s status %d, %d frames in %.3f sec (%.2f FPS)", seq.directory.c_str(), seq.status, seq.frames, seq.seconds, fps);
+        if (seq.eval.frames > 0) {
+            printf(", success AUC %.3f, precision %.3f", seq.eval.successAuc, seq.eval.precision);
+        }
+        printf("\n");
+        if (file != NULL) {
+            fprintf(file, "%s,%d,%d,%.3f,%.2f,", seq.directory.c_str(), seq.status, seq.frames, seq.seconds, fps);
+            if (seq.eval.frames > 0) {
+                fprintf(file, ",%.6f,%.6f\n", seq.eval.successAuc, seq.eval.precision);
+            } else {
+                fprintf(file, ",,\n");
+            }
+        }
+    }
+    double fps = summary.seconds > 0 ? summary.frames/summary.seconds : 0;
+    printf("Batch : %d sequences (%d failed), %ld frames in %.3f sec (%.2f FPS), %.3f CPU sec\n",
+           summary.sequences, summary.failed, summary.frames, summary.seconds, fps, summary.cpuSeconds);
+    if (file != NULL) {
+        fprintf(file, "total,%d,%ld,%.3f,%.2f,%.3f,", summary.failed, summary.frames, summary.seconds, fps, summary.cpuSeconds);
+        if (summary.eval.frames > 0) {
+            fprintf(file, "%.6f,%.6f\n", summary.eval.successAuc, summary.eval.precision);
+        } else {
+            fprintf(file, ",\n");
+        }
+        fclose(file);
+    }
+    return true;
+}
+
+string sequence_name(string directory) {
+    while (directory.size() > 1 && directory[directory.size()-1] == '/') {
+        directory.erase(directory.size()-1);
+    }
+    size_t slash = directory.rfind('/');
+    return slash == string::npos ? directory : directory.substr(slash+1);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_BATCH_H_
+#define _TRACKIMG_BATCH_H_
+
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "evaluation.h"
+
+using namespace std;
+
+/* one sequence of a batch and, once tracked, its result */
+struct batch_sequence
+{
+    string directory;
+    string box;     //"x,y,w,h" of the object, empty for the boxes of the options
+    int status;     //trackimg_error_et of the run
+    int frames;     //frames tracked after the first one
+    double seconds; //wall time of the run
+    evaluation_result eval; //quality of the run, eval.frames is 0 without ground truth
+};
+
+/* aggregate of a batch run */
+struct batch_summary
+{
+    int sequences;
+    int failed;
+    long frames;
+    double seconds;     //wall time of the whole batch
+    double cpuSeconds;  //user+system time of the process during the batch
+    evaluation_result eval; //mean quality of the evaluated sequences, batch throughput
+};
+
+/**
+ * Sequences of <arg>: the directories matching it if it is a glob pattern,
+ * otherwise the lines "directory [x,y,w,h]" of the list file <arg>, empty
+ * lines and lines starting with '#' being skipped.
+ */
+bool list_batch_sequences(string arg, vector<batch_sequence>& sequences);
+
+/**
+ * Track every sequence with track(), at most <jobs> at once on a pool of
+ * worker threads that take the next sequence as soon as they are free.
+ * The OpenMP threads are split between the workers, at least one each.
+ */
+batch_summary run_batch(vector<batch_sequence>& sequences, int jobs, function<int(batch_sequence&)> track);
+
+/**
+ * Print the per-sequence results and the throughput of the batch, and
+ * write them as CSV to <path> unless it is empty. The last line "total"
+ * holds the number of failed sequences as status, and the CPU time, which
+ * is only known for the whole batch.
+ */
+bool write_batch_summary(const vector<batch_sequence>& sequences, const batch_summary& summary, string path);
+
+/* last component of a directory path, used to name per-sequence outputs */
+string sequence_name(string directory);
+
+#endif  /* _TRACKIMG_BATCH_H_ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include "opencv2/highgui/highgui.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+
+#include "display.h"
+
+using namespace cv;
+
+display::display() {
+    m_headless = true;
+    m_running = false;
+    m_capacity = 2;
+    m_dropped = 0;
+}
+
+display::~display() {
+    close();
+}
+
+void display::open(string name, bool headless, int capacity) {
+    m_name = name;
+    m_headless = headless;
+    m_capacity = capacity < 1 ? 1 : capacity;
+    m_dropped = 0;
+    if (m_headless || m_running) {
+        return;
+    }
+    m_running = true;
+    m_thread = thread(&display::run, this);
+}
+
+void display::push(const Mat& frame, const Rect& bbox, int thickness) {
+    push(frame, vector<Rect>(1, bbox), vector<int>(1, thickness));
+}
+
+void display::push(const Mat& frame, const vector<Rect>& bboxes, const vector<int>& thicknesses) {
+    if (m_headless) {
+        return;
+    }
+    display_item item;
+    item.frame = frame;     //no copy, the consumer draws on its own clone
+    item.bboxes = bboxes;
+    item.thicknesses = thicknesses;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if ((int)m_queue.size() >= m_capacity) {
+            //never stall the tracker: drop the oldest pending frame
+            m_queue.pop_front();
+            m_dropped++;
+        }
+        m_queue.push_back(item);
+    }
+    m_cond.notify_one();
+}
+
+void display::close() {
+    if (!m_running) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_cond.notify_one();
+    m_thread.join();
+}
+
+bool display::isHeadless() {
+    return m_headless;
+}
+
+int display::getDroppedFrames() {
+    lock_guard<mutex> lock(m_mutex);
+    return m_dropped;
+}
+
+void display::run() {
+    namedWindow(m_name, CV_WINDOW_AUTOSIZE);
+    for (;;) {
+        display_item item;
+        {
+            unique_lock<mutex> lock(m_mutex);
+            //wake up regularly to keep the window responsive
+            m_cond.wait_for(lock, chrono::milliseconds(30), [this]{ return !m_queue.empty() || !m_running; });
+            if (m_queue.empty()) {
+                if (!m_running) {
+                    break;
+                }
+                lock.unlock();
+                waitKey(1);
+                continue;
+            }
+            item = m_queue.front();
+            m_queue.pop_front();
+        }
+        Mat c = item.frame.clone();
+        for (size_t i=0; i<item.bboxes.size(); i++) {
+            if (item.bboxes[i].area() > 0) {
+                rectangle(c, item.bboxes[i].tl(), item.bboxes[i].br(), Scalar(0,0, 255), item.thicknesses[i]);
+            }
+        }
+        imshow(m_name, c);
+        waitKey(1);
+    }
+    destroyWindow(m_name);
+}
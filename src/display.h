@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_DISPLAY_H_
+#define _TRACKIMG_DISPLAY_H_
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include "opencv2/core/core.hpp"
+
+using namespace std;
+
+/*
+ * Asynchronous display of the tracking results.
+ *
+ * The tracker only pushes (frame, bboxes) pairs into a bounded queue, a
+ * consumer thread owns the HighGUI window and draws them. When the queue
+ * is full the oldest pending frame is dropped, so the tracker never waits
+ * for the display. In headless mode nothing is queued and HighGUI is never
+ * called.
+ */
+class display
+{
+public:
+    display();
+    ~display();
+
+    void open(string name, bool headless, int capacity);
+    void push(const cv::Mat& frame, const cv::Rect& bbox, int thickness);
+    void push(const cv::Mat& frame, const vector<cv::Rect>& bboxes, const vector<int>& thicknesses);
+    void close();
+
+    bool isHeadless();
+    int getDroppedFrames();
+
+private:
+    struct display_item
+    {
+        cv::Mat frame;      //8-bit BGR frame, as decoded
+        vector<cv::Rect> bboxes;    //boxes to draw, one per target
+        vector<int> thicknesses;
+    };
+
+    void run();
+
+    string m_name;
+    bool m_headless;
+    bool m_running;
+    int m_capacity;
+    int m_dropped;
+
+    deque<display_item> m_queue;
+    mutex m_mutex;
+    condition_variable m_cond;
+    thread m_thread;
+};
+
+#endif  /* _TRACKIMG_DISPLAY_H_ */
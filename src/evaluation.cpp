@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "evaluation.h"
+
+using namespace cv;
+
+bool evaluation::load(string path) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    m_truth.clear();
+    string line;
+    while (getline(file, line)) {
+        replace(line.begin(), line.end(), ',', ' ');
+        replace(line.begin(), line.end(), '\t', ' ');
+        double x, y, w, h;
+        if (sscanf(line.c_str(), "%lf %lf %lf %lf", &x, &y, &w, &h) == 4) {
+            m_truth.push_back(Rect_<double>(x, y, w, h));
+        } else {
+            m_truth.push_back(Rect_<double>()); //keeps the next lines on their frame
+        }
+    }
+    return !m_truth.empty();
+}
+
+bool evaluation::isLoaded() {
+    return !m_truth.empty();
+}
+
+Rect_<double> evaluation::truth(int frame) {
+    if (frame < 1 || frame > (int)m_truth.size()) {
+        return Rect_<double>();
+    }
+    //OTB boxes start at 1, the ones of the tracker at 0
+    Rect_<double> gt = m_truth[frame-1];
+    if (gt.width > 0 && gt.height > 0) {
+        gt.x -= 1;
+        gt.y -= 1;
+    }
+    return gt;
+}
+
+double evaluation::add(int frame, Rect r) {
+    Rect_<double> gt = truth(frame);
+    Rect_<double> box(r.x, r.y, r.width, r.height);
+    if (!(gt.width > 0 && gt.height > 0)) {
+        return -1;
+    }
+    Rect_<double> inter = gt & box;
+    double area = inter.width > 0 && inter.height > 0 ? inter.area() : 0;
+    double iou = area / (gt.area() + box.area() - area);
+    double dx = (gt.x + gt.width/2) - (box.x + box.width/2);
+    double dy = (gt.y + gt.height/2) - (box.y + box.height/2);
+    m_iou.push_back(iou);
+    m_error.push_back(sqrt(dx*dx + dy*dy));
+    return iou;
+}
+
+evaluation_result evaluation::result(double fps) {
+    evaluation_result r;
+    r.frames = m_iou.size();
+    r.fps = fps;
+    r.meanIou = 0;
+    r.successAuc = 0;
+    r.precision = 0;
+    if (r.frames == 0) {
+        return r;
+    }
+    for (int i=0; i<r.frames; i++) {
+        r.meanIou += m_iou[i];
+        if (m_error[i] <= EVALUATION_PRECISION_THRESHOLD) {
+            r.precision++;
+        }
+    }
+    r.meanIou /= r.frames;
+    r.precision /= r.frames;
+    //success rate at the thresholds 0, 0.05, ..., 1 as in the OTB toolkit
+    for (int t=0; t<=20; t++) {
+        int success = 0;
+        for (int i=0; i<r.frames; i++) {
+            if (m_iou[i] > t*0.05) {
+                success++;
+            }
+        }
+        r.successAuc += (double)success/r.frames;
+    }
+    r.successAuc /= 21;
+    return r;
+}
+
+bool read_baseline(string path, evaluation_result& baseline) {
+    ifstream file(path.c_str());
+    if (!file.is_open()) {
+        return false;
+    }
+    baseline.frames = 0;
+    baseline.meanIou = baseline.successAuc = baseline.precision = baseline.fps = 0;
+    int found = 0;
+    string line;
+    while (getline(file, line)) {
+        istringstream fields(line);
+        string name;
+        double value;
+        if (!(fields >> name >> value)) {
+            continue;
+        }
+        if (name == "success_auc") {
+            baseline.successAuc = value;
+            found++;
+        } else if (name == "precision") {
+            baseline.precision = value;
+            found++;
+        } else if (name == "mean_iou") {
+            baseline.meanIou = value;
+        } else if (name == "fps") {
+            baseline.fps = value;
+        } else if (name == "frames") {
+            baseline.frames = (int)value;
+        }
+    }
+    return found == 2;
+}
+
+bool write_baseline(string path, const evaluation_result& result) {
+    FILE* file = fopen(path.c_str(), "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "success_auc %.6f\nprecision %.6f\nmean_iou %.6f\nfps %.3f\nframes %d\n",
+            result.successAuc, result.precision, result.meanIou, result.fps, result.frames);
+    return fclose(file) == 0;
+}
+
+bool evaluation_regressed(const evaluation_result& result, const evaluation_result& baseline, double tolerance) {
+    return result.successAuc < baseline.successAuc - tolerance || result.precision < baseline.precision - tolerance;
+}
+
+void print_evaluation(const evaluation_result& result, const evaluation_result* baseline) {
+    printf("Evaluation : %d frames, mean IoU %.3f, success AUC %.3f, precision@%d %.3f, %.2f FPS\n",
+           result.frames, result.meanIou, result.successAuc, EVALUATION_PRECISION_THRESHOLD, result.precision, result.fps);
+    if (baseline != NULL) {
+        printf("Baseline   : %d frames, mean IoU %.3f, success AUC %.3f, precision@%d %.3f, %.2f FPS (x%.2f)\n",
+               baseline->frames, baseline->meanIou, baseline->successAuc, EVALUATION_PRECISION_THRESHOLD, baseline->precision, baseline->fps,
+               baseline->fps > 0 ? result.fps/baseline->fps : 0);
+    }
+}
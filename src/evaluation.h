@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_EVALUATION_H_
+#define _TRACKIMG_EVALUATION_H_
+
+#include <string>
+#include <vector>
+#include "opencv2/core/core.hpp"
+
+using namespace std;
+
+/* center error of a frame to be counted as precise, in pixels */
+#define EVALUATION_PRECISION_THRESHOLD 20
+
+/* quality and speed of a run */
+struct evaluation_result
+{
+    int frames;         //frames compared with a ground-truth box
+    double meanIou;
+    double successAuc;  //area under the success plot, IoU thresholds 0:0.05:1
+    double precision;   //rate of frames with a center error <= EVALUATION_PRECISION_THRESHOLD
+    double fps;
+};
+
+/*
+ * Comparison of the boxes of a run with ground-truth boxes in the OTB
+ * groundtruth_rect.txt layout: one "x,y,w,h" line per frame, from frame 1,
+ * the separators being commas, tabs or spaces. Frames whose ground truth
+ * is missing or empty are not counted.
+ */
+class evaluation
+{
+public:
+    bool load(string path);
+    bool isLoaded();
+
+    /**
+     * Ground-truth box of frame <frame>, numbered from 1, empty if none.
+     * It is moved to the 0-based coordinates of the tracker.
+     */
+    cv::Rect_<double> truth(int frame);
+
+    /**
+     * Compare the box of frame <frame> with its ground truth, and return
+     * their IoU, -1 if the frame has no ground truth.
+     */
+    double add(int frame, cv::Rect box);
+
+    evaluation_result result(double fps);
+
+private:
+    vector< cv::Rect_<double> > m_truth;
+    vector<double> m_iou;
+    vector<double> m_error;
+};
+
+/* "name value" lines: success_auc, precision, mean_iou, fps, frames */
+bool read_baseline(string path, evaluation_result& baseline);
+bool write_baseline(string path, const evaluation_result& result);
+
+/**
+ * True when the success AUC or the precision of <result> dropped by more
+ * than <tolerance> below <baseline>. The speed is only reported, it
+ * depends on the machine.
+ */
+bool evaluation_regressed(const evaluation_result& result, const evaluation_result& baseline, double tolerance);
+
+void print_evaluation(const evaluation_result& result, const evaluation_result* baseline);
+
+#endif  /* _TRACKIMG_EVALUATION_H_ */
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "tracker.h"
+#include "feature.h"
+
+using namespace std;
+
+template<typename _Tp>
+feature_extractor<_Tp>::feature_extractor(int mode, int h, int w) :
+    m_mode(mode), m_h(h), m_w(w)
+{
+    int cell = (m_mode == FEATURE_HOG) ? TRACKIMG_FEATURE_HOG_CELL : TRACKIMG_FEATURE_LUMA_CELL;
+    m_cellsH = std::max(1, m_h/cell);
+    m_cellsW = std::max(1, m_w/cell);
+    m_cellH = std::max(1, m_h/m_cellsH);
+    m_cellW = std::max(1, m_w/m_cellsW);
+
+    int q = TRACKIMG_FEATURE_COLOR_BINS;
+    if (m_mode == FEATURE_LUMA) {
+        m_size = m_cellsH*m_cellsW;
+    } else if (m_mode == FEATURE_HOG) {
+        m_size = m_cellsH*m_cellsW*TRACKIMG_FEATURE_HOG_BINS + q*q*q;
+    } else {
+        m_size = m_h*m_w*3;
+    }
+}
+
+template<typename _Tp>
+double feature_extractor<_Tp>::noise() const
+{
+    //the HOG and color parts have unit norms, the pixels and luma range up to 255
+    return (m_mode == FEATURE_HOG) ? 1.0/255 : 1.0;
+}
+
+template<typename _Tp>
+Mat feature_extractor<_Tp>::windows(Mat A, int wbh, int wbw, vector<window_index>& idx) const
+{
+    if (m_mode == FEATURE_PIXELS) {
+        return im_seg_windows<_Tp>(A, m_h, m_w, wbh, wbw, idx);
+    }
+
+    //number of windows in each direction, as im_seg_windows
+    int y = (A.rows-m_h+1 > 0) ? (A.rows-m_h+wbh)/wbh : 0;
+    int x = (A.cols-m_w+1 > 0) ? (A.cols-m_w+wbw)/wbw : 0;
+    Mat F(x*y, m_size, TRACKIMG_TYPE(_Tp,1));
+    idx.resize(x*y);
+    if (x*y == 0) {
+        return F;
+    }
+
+    //luma of A, in the RGB order of the tracker frames
+    Mat L(A.rows, A.cols, TRACKIMG_TYPE(_Tp,1));
+    for (int r=0; r<A.rows; r++) {
+        const _Tp* a = A.ptr<_Tp>(r);
+        _Tp* l = L.ptr<_Tp>(r);
+        for (int c=0; c<A.cols; c++) {
+            l[c] = (_Tp)(0.299*a[3*c] + 0.587*a[3*c+1] + 0.114*a[3*c+2]);
+        }
+    }
+
+    //gradient magnitude, orientation bin and color bin of every pixel
+    Mat M, O, C;
+    if (m_mode == FEATURE_HOG) {
+        int q = TRACKIMG_FEATURE_COLOR_BINS;
+        M.create(A.rows, A.cols, TRACKIMG_TYPE(_Tp,1));
+        O.create(A.rows, A.cols, CV_8U);
+        C.create(A.rows, A.cols, CV_8U);
+        for (int r=0; r<A.rows; r++) {
+            const _Tp* a = A.ptr<_Tp>(r);
+            const _Tp* l = L.ptr<_Tp>(r);
+            const _Tp* lu = L.ptr<_Tp>(std::max(r-1, 0));
+            const _Tp* ld = L.ptr<_Tp>(std::min(r+1, A.rows-1));
+            _Tp* m = M.ptr<_Tp>(r);
+            uchar* o = O.ptr<uchar>(r);
+            uchar* cb = C.ptr<uchar>(r);
+            for (int c=0; c<A.cols; c++) {
+                double gx = l[std::min(c+1, A.cols-1)] - l[std::max(c-1, 0)];
+                double gy = ld[c] - lu[c];
+                double t = atan2(gy, gx);
+                if (t < 0) {
+                    t += CV_PI;
+                }
+                m[c] = (_Tp)sqrt(gx*gx + gy*gy);
+                o[c] = (uchar)std::min((int)(t*TRACKIMG_FEATURE_HOG_BINS/CV_PI), TRACKIMG_FEATURE_HOG_BINS-1);
+                int bin = 0;
+                for (int ch=0; ch<3; ch++) {
+                    //the background samples hide the object with noise out of [0, 255]
+                    int v = std::min(std::max((int)(a[3*c+ch]*q/256), 0), q-1);
+                    bin = bin*q + v;
+                }
+                cb[c] = (uchar)bin;
+            }
+        }
+    }
+
+    #pragma omp parallel for
+    for (int ii=0; ii<y; ii++)
+    {
+        for (int jj=0; jj<x; jj++)
+        {
+            int atom = ii*x + jj;
+            _Tp* f = F.ptr<_Tp>(atom);
+            if (m_mode == FEATURE_LUMA) {
+                luma(L, ii*wbh, jj*wbw, f);
+            } else {
+                hog(M, O, C, ii*wbh, jj*wbw, f);
+            }
+            idx[atom].i = ii;
+            idx[atom].j = jj;
+            idx[atom].w = m_w;
+            idx[atom].h = m_h;
+        }
+    }
+    return F;
+}
+
+template<typename _Tp>
+void feature_extractor<_Tp>::luma(const Mat& L, int y0, int x0, _Tp* f) const
+{
+    double inv = 1.0/(m_cellH*m_cellW);
+    for (int cy=0; cy<m_cellsH; cy++) {
+        for (int cx=0; cx<m_cellsW; cx++) {
+            double s = 0;
+            for (int r=0; r<m_cellH; r++) {
+                const _Tp* l = L.ptr<_Tp>(y0 + cy*m_cellH + r) + x0 + cx*m_cellW;
+                for (int c=0; c<m_cellW; c++) {
+                    s += l[c];
+                }
+            }
+            f[cy*m_cellsW + cx] = (_Tp)(s*inv);
+        }
+    }
+}
+
+template<typename _Tp>
+void feature_extractor<_Tp>::hog(const Mat& M, const Mat& O, const Mat& C, int y0, int x0, _Tp* f) const
+{
+    int nh = m_cellsH*m_cellsW*TRACKIMG_FEATURE_HOG_BINS;
+    std::fill(f, f + m_size, (_Tp)0);
+
+    //orientation histograms of the cells, weighted by the gradient magnitude
+    for (int r=0; r<m_cellsH*m_cellH; r++) {
+        const _Tp* m = M.ptr<_Tp>(y0 + r) + x0;
+        const uchar* o = O.ptr<uchar>(y0 + r) + x0;
+        _Tp* fr = f + (r/m_cellH)*m_cellsW*TRACKIMG_FEATURE_HOG_BINS;
+        for (int c=0; c<m_cellsW*m_cellW; c++) {
+            fr[(c/m_cellW)*TRACKIMG_FEATURE_HOG_BINS + o[c]] += m[c];
+        }
+    }
+    //color histogram of the whole window
+    for (int r=0; r<m_h; r++) {
+        const uchar* cb = C.ptr<uchar>(y0 + r) + x0;
+        for (int c=0; c<m_w; c++) {
+            f[nh + cb[c]] += 1;
+        }
+    }
+
+    //both parts to unit norm, so none outweighs the other
+    int start[3] = {0, nh, m_size};
+    for (int p=0; p<2; p++) {
+        double s = 0;
+        for (int i=start[p]; i<start[p+1]; i++) {
+            s += (double)f[i]*f[i];
+        }
+        double inv = 1/sqrt(s + 1e-12);
+        for (int i=start[p]; i<start[p+1]; i++) {
+            f[i] = (_Tp)(f[i]*inv);
+        }
+    }
+}
+
+/* Explicit instantiations */
+template class feature_extractor<float>;
+template class feature_extractor<double>;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_FEATURE_H_
+#define _TRACKIMG_FEATURE_H_
+
+#include <vector>
+#include "opencv2/core/core.hpp"
+
+#include "tracker.h"
+
+using namespace cv;
+
+/* Features of the atoms of the dictionaries */
+typedef enum {
+    FEATURE_PIXELS = 0,     /* RGB pixels of the window, reference */
+    FEATURE_LUMA,           /* luma averaged over cells of TRACKIMG_FEATURE_LUMA_CELL pixels */
+    FEATURE_HOG,            /* gradient orientation histograms of cells and color histogram */
+    FEATURE_SIZE
+} feature_et;
+
+/* side of the luma cells, in pixels */
+#define TRACKIMG_FEATURE_LUMA_CELL 2
+/* side of the HOG cells, in pixels */
+#define TRACKIMG_FEATURE_HOG_CELL 6
+/* unsigned orientation bins of a HOG cell */
+#define TRACKIMG_FEATURE_HOG_BINS 9
+/* bins per channel of the color histogram */
+#define TRACKIMG_FEATURE_COLOR_BINS 4
+
+/*
+ * Features of the h*w windows of an image, one atom per row, used alike
+ * for Tar.fea, Tar.feaN and the sliding windows of the first stage.
+ *
+ * The cells of a window are the largest ones not above the nominal side
+ * that tile it, the last rows and columns of pixels left over are not
+ * read. The luma and the gradients are computed once per image for all
+ * its windows.
+ */
+template<typename _Tp>
+class feature_extractor
+{
+public:
+    feature_extractor(int mode, int h, int w);
+
+    /* size of an atom */
+    int size() const { return m_size; }
+
+    /* std of the template noise, for a noise of 1 on the pixels */
+    double noise() const;
+
+    /**
+     * Features of all the windows of A taken every wbh rows and wbw
+     * columns, one per row, with their steps and size in idx, as
+     * im_seg_windows().
+     */
+    Mat windows(Mat A, int wbh, int wbw, std::vector<window_index>& idx) const;
+
+private:
+    void luma(const Mat& L, int y0, int x0, _Tp* f) const;
+    void hog(const Mat& M, const Mat& O, const Mat& C, int y0, int x0, _Tp* f) const;
+
+    int m_mode;
+    int m_h;        //size of the windows
+    int m_w;
+    int m_cellsH;   //cells of a window
+    int m_cellsW;
+    int m_cellH;    //size of a cell
+    int m_cellW;
+    int m_size;
+};
+
+#endif  /* _TRACKIMG_FEATURE_H_ */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <algorithm>
+
+#include "tracker.h"
+#include "frame.h"
+
+using namespace std;
+
+template<typename _Tp>
+frame_context<_Tp>::frame_context() :
+    m_tilesX(0), m_tilesY(0)
+{
+}
+
+template<typename _Tp>
+void frame_context<_Tp>::reset(const Mat& frame_c)
+{
+    lock_guard<mutex> guard(m_lock);
+    m_frame_c = frame_c;
+    //same size frames keep their cache, only the tiles are marked stale
+    m_cache.create(frame_c.rows, frame_c.cols, TRACKIMG_TYPE(_Tp,3));
+    m_tilesX = (frame_c.cols + TRACKIMG_FRAME_TILE - 1)/TRACKIMG_FRAME_TILE;
+    m_tilesY = (frame_c.rows + TRACKIMG_FRAME_TILE - 1)/TRACKIMG_FRAME_TILE;
+    m_done.assign(m_tilesX*m_tilesY, 0);
+}
+
+template<typename _Tp>
+Mat frame_context<_Tp>::roi(Rect r)
+{
+    r &= Rect(0, 0, m_frame_c.cols, m_frame_c.rows);
+    if (r.area() <= 0) {
+        return Mat();
+    }
+    int tx0 = r.x/TRACKIMG_FRAME_TILE, tx1 = (r.x + r.width - 1)/TRACKIMG_FRAME_TILE;
+    int ty0 = r.y/TRACKIMG_FRAME_TILE, ty1 = (r.y + r.height - 1)/TRACKIMG_FRAME_TILE;
+
+    lock_guard<mutex> guard(m_lock);
+    for (int ty=ty0; ty<=ty1; ty++) {
+        for (int tx=tx0; tx<=tx1; tx++) {
+            if (m_done[ty*m_tilesX + tx]) {
+                continue;
+            }
+            //re-arange RGB and convert to float/double in one pass
+            int x0 = tx*TRACKIMG_FRAME_TILE, x1 = std::min(x0 + TRACKIMG_FRAME_TILE, m_frame_c.cols);
+            int y1 = std::min((ty+1)*TRACKIMG_FRAME_TILE, m_frame_c.rows);
+            for (int y=ty*TRACKIMG_FRAME_TILE; y<y1; y++) {
+                const uchar* s = m_frame_c.ptr<uchar>(y);
+                _Tp* d = m_cache.ptr<_Tp>(y);
+                for (int x=x0; x<x1; x++) {
+                    d[3*x] = s[3*x+2];
+                    d[3*x+1] = s[3*x+1];
+                    d[3*x+2] = s[3*x];
+                }
+            }
+            m_done[ty*m_tilesX + tx] = 1;
+        }
+    }
+    return m_cache(r);
+}
+
+/* Explicit instantiations */
+template class frame_context<float>;
+template class frame_context<double>;
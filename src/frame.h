@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_FRAME_H_
+#define _TRACKIMG_FRAME_H_
+
+#include <vector>
+#include <mutex>
+#include "opencv2/core/core.hpp"
+
+using namespace cv;
+
+/* side of the tiles converted at once, in pixels */
+#define TRACKIMG_FRAME_TILE 32
+
+/*
+ * One decoded frame as seen by the tracker.
+ *
+ * The 8-bit BGR frame is kept as decoded; the RGB _Tp pixels the tracker
+ * works on are converted tile by tile, only where a region asks for them,
+ * into a cache of the frame size. Regions are views of the cache, so
+ * overlapping ones share their pixels and must not be written. The cache
+ * is reused from frame to frame and the targets of a frame can ask for
+ * regions concurrently.
+ */
+template<typename _Tp>
+class frame_context
+{
+public:
+    frame_context();
+
+    /* frame_c is the frame of the next regions, the previous ones are invalidated */
+    void reset(const Mat& frame_c);
+
+    int rows() const { return m_frame_c.rows; }
+    int cols() const { return m_frame_c.cols; }
+
+    /* the decoded 8-bit BGR frame */
+    const Mat& bgr() const { return m_frame_c; }
+
+    /* rectangle r of the frame as RGB _Tp pixels, converted on first access */
+    Mat roi(Rect r);
+
+private:
+    Mat m_frame_c;
+    Mat m_cache;                    //converted pixels, TRACKIMG_TYPE(_Tp,3)
+    std::vector<uchar> m_done;      //converted tiles, row-major
+    int m_tilesX;
+    int m_tilesY;
+    std::mutex m_lock;
+};
+
+#endif  /* _TRACKIMG_FRAME_H_ */
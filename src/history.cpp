@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <algorithm>
+
+#include "history.h"
+
+history_ring::history_ring() :
+    m_pinned(0), m_count(0), m_head(0)
+{
+}
+
+void history_ring::assign(const Mat& init, int pinned, int capacity)
+{
+    int cap = std::max(capacity, init.rows);
+    m_data.create(cap, init.cols, init.type());
+    init.copyTo(m_data.rowRange(0, init.rows));
+    m_pinned = std::min(pinned, init.rows);
+    m_count = init.rows - m_pinned;
+    m_head = 0;
+}
+
+int history_ring::slot(int i) const
+{
+    if (i < m_pinned) {
+        return i;
+    }
+    return m_pinned + (m_head + i - m_pinned) % (m_data.rows - m_pinned);
+}
+
+Mat history_ring::row(int i) const
+{
+    return m_data.row(slot(i));
+}
+
+Mat history_ring::col(int i) const
+{
+    return m_data.row(slot(i)).reshape(0, m_data.cols);
+}
+
+Mat history_ring::view() const
+{
+    return m_data.rowRange(0, size());
+}
+
+void history_ring::pushFront(const Mat& items)
+{
+    int rc = m_data.rows - m_pinned;
+    for (int r=items.rows-1; r>=0; r--) {
+        //the new head takes the slot of the oldest item once full
+        m_head = (m_head + rc - 1) % rc;
+        Mat dst = m_data.row(m_pinned + m_head);
+        items.row(r).copyTo(dst);
+        m_count = std::min(m_count + 1, rc);
+    }
+}
+
+void history_ring::pushBack(const Mat& items)
+{
+    int rc = m_data.rows - m_pinned;
+    for (int r=0; r<items.rows; r++) {
+        Mat dst = m_data.row(m_pinned + (m_head + m_count) % rc);
+        items.row(r).copyTo(dst);
+        if (m_count < rc) {
+            m_count++;
+        } else {
+            m_head = (m_head + 1) % rc;
+        }
+    }
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_HISTORY_H_
+#define _TRACKIMG_HISTORY_H_
+
+#include "opencv2/core/core.hpp"
+
+using namespace cv;
+
+/*
+ * Fixed-capacity history of items of equal size, one item per row of a
+ * preallocated matrix. The first <pinned> rows never move; the other
+ * rows form a circular buffer, so adding k items costs O(k) rows however
+ * long the history is.
+ *
+ * Items are addressed by their logical index: pushFront() puts the new
+ * items at index <pinned> and ages the older ones towards the end,
+ * pushBack() appends them after the newest one. When the buffer is full
+ * the oldest items are overwritten.
+ *
+ * Copies share the storage, like cv::Mat.
+ */
+class history_ring
+{
+public:
+    history_ring();
+
+    /**
+     * Take the rows of init as the content. The first pinned rows are
+     * never moved; capacity is the max number of items, init.rows if 0.
+     */
+    void assign(const Mat& init, int pinned = 0, int capacity = 0);
+
+    int size() const { return m_pinned + m_count; }
+    int cols() const { return m_data.cols; }
+
+    /* item i as a 1*cols view */
+    Mat row(int i) const;
+
+    /* item i as a cols*1 view */
+    Mat col(int i) const;
+
+    /**
+     * All the items as one contiguous view, in storage order: the logical
+     * order up to a rotation of the ring part. Only valid while the ring
+     * part is full or has only been grown by pushBack().
+     */
+    Mat view() const;
+
+    void pushFront(const Mat& items);
+    void pushBack(const Mat& items);
+
+private:
+    int slot(int i) const;
+
+    Mat m_data;
+    int m_pinned;
+    int m_count;    //items in the ring part
+    int m_head;     //slot of the first ring item, relative to m_pinned
+};
+
+#endif  /* _TRACKIMG_HISTORY_H_ */
@@ -0,0 +1,631 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * @author Weizhi Liu (MatLab version of the Algorithm)
+ * @author Giang Truong Nguyen (C/C++ version of the Algorithm)
+ *
+ * Maintainers :
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+#include <math.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+
+#include "tracker.h"
+#include "lars.h"
+#include "linalg.h"
+
+using namespace std;
+
+/*
+ * Lower triangular Cholesky factor L of the active Gram matrix
+ * Xa'Xa + 1e-8*I, grown by one row each time an atom enters the active set.
+ * Kept in double whatever the scalar type of the dictionary.
+ */
+class chol_factor
+{
+public:
+    chol_factor(int capacity) : m_k(0), m_cap(capacity), m_L(capacity*capacity, 0.0) {}
+
+    int size() const { return m_k; }
+
+    //append the atom whose inner products with the active atoms are g and whose squared norm is d
+    void append(const double* g, double d)
+    {
+        if (m_k == m_cap) {
+            grow();
+        }
+        double* l = &m_L[m_k*m_cap];
+        double ll = 0;
+        for (int r=0; r<m_k; r++) {     //forward substitution L*l = g
+            const double* Lr = &m_L[r*m_cap];
+            double v = g[r];
+            for (int q=0; q<r; q++) {
+                v -= Lr[q]*l[q];
+            }
+            l[r] = v/Lr[r];
+            ll += l[r]*l[r];
+        }
+        double lambda2 = d + 0.00000001 - ll;
+        l[m_k] = sqrt(lambda2 > 1e-12 ? lambda2 : 1e-12);
+        m_k++;
+    }
+
+    //solve L*L'*w = s
+    void solve(const double* s, double* w) const
+    {
+        for (int r=0; r<m_k; r++) {
+            const double* Lr = &m_L[r*m_cap];
+            double v = s[r];
+            for (int q=0; q<r; q++) {
+                v -= Lr[q]*w[q];
+            }
+            w[r] = v/Lr[r];
+        }
+        for (int r=m_k-1; r>=0; r--) {
+            double v = w[r];
+            for (int q=r+1; q<m_k; q++) {
+                v -= m_L[q*m_cap+r]*w[q];
+            }
+            w[r] = v/m_L[r*m_cap+r];
+        }
+    }
+
+private:
+    void grow()
+    {
+        int cap = 2*m_cap;
+        vector<double> L(cap*cap, 0.0);
+        for (int r=0; r<m_k; r++) {
+            for (int q=0; q<=r; q++) {
+                L[r*cap+q] = m_L[r*m_cap+q];
+            }
+        }
+        m_L.swap(L);
+        m_cap = cap;
+    }
+
+    int m_k;
+    int m_cap;
+    vector<double> m_L;
+};
+
+/* atoms of the significant coefficients of beta0, largest first, at most nu+1 */
+template<typename _Tp>
+static vector<int> lars_warm_atoms(const Mat& beta0, double nu)
+{
+    double b_m = 0;
+    for (int j=0; j<beta0.rows; j++) {
+        b_m = std::max(b_m, (double)fabs(beta0.at<_Tp>(j, 0)));
+    }
+    vector<pair<double,int> > nz;
+    for (int j=0; j<beta0.rows; j++) {
+        double v = fabs(beta0.at<_Tp>(j, 0));
+        if (v > 0 && v >= TRACKIMG_LARS_WARM_RATIO*b_m) {
+            nz.push_back(make_pair(-v, j));
+        }
+    }
+    std::sort(nz.begin(), nz.end());
+    vector<int> Sa;
+    for (size_t q=0; q<nz.size() && q<(size_t)nu+1 && q+1<(size_t)beta0.rows; q++) {
+        Sa.push_back(nz[q].second);
+    }
+    return Sa;
+}
+
+/*
+ * Point of the LAR path where Sa is the active set: with u = Ga^-1*Xa'*y
+ * and w = Ga^-1*s, beta(Sa) = u - lambda*w gives the correlations
+ * c0 + lambda*d, c0 = X'*(y-Xa*u) and d = X'*Xa*w, and lambda*s on Sa.
+ * Returns the smallest lambda >= 0 at which no other atom is more
+ * correlated than lambda, with in p_h the atom reaching it (-1 at 0), or
+ * -1 when there is none, the active set being off the path.
+ */
+static double lars_warm_lambda(const vector<double>& c0, const vector<double>& d, const vector<char>& active, int& p_h)
+{
+    double lo = 0;
+    double hi = numeric_limits<double>::infinity();
+    p_h = -1;
+    for (size_t j=0; j<c0.size(); j++) {
+        if (active[j]) {
+            continue;
+        }
+        //c0+lambda*d <= lambda and -(c0+lambda*d) <= lambda, as a*lambda >= b
+        double a[2] = { 1 - d[j], 1 + d[j] };
+        double b[2] = { c0[j], -c0[j] };
+        for (int e=0; e<2; e++) {
+            if (a[e] > 0) {
+                if (b[e]/a[e] > lo) {
+                    lo = b[e]/a[e];
+                    p_h = (int)j;
+                }
+            } else if (a[e] < 0) {
+                hi = std::min(hi, b[e]/a[e]);
+            } else if (b[e] > 0) {
+                return -1;
+            }
+        }
+    }
+    return (lo <= hi) ? lo : -1;
+}
+
+template<typename _Tp>
+Mat lars_chol(Mat y, Mat X, double err, double nu, Mat beta0)
+{
+    int m=X.rows;
+    int n=X.cols;
+    Mat beta(n, 1, TRACKIMG_TYPE(_Tp,1), Scalar(0));
+    if (n == 0) {
+        return beta;
+    }
+    //residual and correlations, only updated incrementally afterwards
+    Mat yr = y.clone();
+    Mat c;
+    linalg_gemm<_Tp>(X, yr, c, GEMM_1_T);
+    _Tp* pc = c.ptr<_Tp>(0);
+    _Tp* pyr = yr.ptr<_Tp>(0);
+    _Tp* pbeta = beta.ptr<_Tp>(0);
+
+    //active set, in entering order
+    vector<int> Sa;
+    vector<char> active(n, 0);
+    int cap = std::min(n, (int)nu+3);
+    Mat Xa(cap, m, TRACKIMG_TYPE(_Tp,1));    //active atoms, one contiguous row each
+    chol_factor L(cap);
+    vector<double> g(cap), s(cap), w(cap);
+    vector<int> entering;
+    int i=0;
+
+    //=== add the entering atoms to the active set and to the Cholesky factor ===
+    auto enter = [&]() {
+        for (size_t e=0; e<entering.size(); e++) {
+            int j = entering[e];
+            int k = (int)Sa.size();
+            if (k == Xa.rows) {
+                Mat Xa2(2*Xa.rows, m, Xa.type());
+                Xa.copyTo(Xa2.rowRange(0, k));
+                Xa = Xa2;
+                g.resize(2*k); s.resize(2*k); w.resize(2*k);
+            }
+            _Tp* xj = Xa.ptr<_Tp>(k);
+            double d = 0;
+            for (int r=0; r<m; r++) {
+                xj[r] = X.at<_Tp>(r, j);
+                d += (double)xj[r]*xj[r];
+            }
+            for (int q=0; q<k; q++) {
+                const _Tp* xq = Xa.ptr<_Tp>(q);
+                double v = 0;
+                for (int r=0; r<m; r++) {
+                    v += (double)xq[r]*xj[r];
+                }
+                g[q] = v;
+            }
+            L.append(&g[0], d);
+            Sa.push_back(j);
+            active[j] = 1;
+        }
+        entering.clear();
+    };
+
+    //=== warm start: the previous active set, moved to its point of the path for y ===
+    if (!beta0.empty()) {
+        entering = lars_warm_atoms<_Tp>(beta0, nu);
+        enter();
+        int k = (int)Sa.size();
+        vector<double> u(k), ya(k);
+        for (int q=0; q<k; q++) {
+            s[q] = beta0.at<_Tp>(Sa[q], 0) < 0 ? -1 : 1;
+            const _Tp* xq = Xa.ptr<_Tp>(q);
+            double v = 0;
+            for (int r=0; r<m; r++) {
+                v += (double)xq[r]*pyr[r];
+            }
+            ya[q] = v;
+        }
+        L.solve(&ya[0], &u[0]);
+        L.solve(&s[0], &w[0]);
+        //residual of the least squares on Sa and the direction Xa*w
+        Mat r0 = y.clone();
+        Mat v(m, 1, TRACKIMG_TYPE(_Tp,1), Scalar(0));
+        _Tp* pr0 = r0.ptr<_Tp>(0);
+        _Tp* pv = v.ptr<_Tp>(0);
+        for (int q=0; q<k; q++) {
+            const _Tp* xq = Xa.ptr<_Tp>(q);
+            _Tp uq = (_Tp)u[q], wq = (_Tp)w[q];
+            for (int r=0; r<m; r++) {
+                pr0[r] -= uq*xq[r];
+                pv[r] += wq*xq[r];
+            }
+        }
+        Mat c0, d0;
+        linalg_gemm<_Tp>(X, r0, c0, GEMM_1_T);
+        linalg_gemm<_Tp>(X, v, d0, GEMM_1_T);
+        vector<double> c0v(n), dv(n);
+        for (int j=0; j<n; j++) {
+            c0v[j] = c0.at<_Tp>(j, 0);
+            dv[j] = d0.at<_Tp>(j, 0);
+        }
+        int p_h;
+        double lambda = (k > 0) ? lars_warm_lambda(c0v, dv, active, p_h) : -1;
+        if (lambda >= 0) {
+            for (int q=0; q<k; q++) {
+                pbeta[Sa[q]] = (_Tp)(u[q] - lambda*w[q]);
+            }
+            for (int r=0; r<m; r++) {
+                pyr[r] = pr0[r] + (_Tp)lambda*pv[r];
+            }
+            for (int j=0; j<n; j++) {
+                pc[j] = (_Tp)(c0v[j] + lambda*dv[j]);
+            }
+            for (int q=0; q<k; q++) {
+                pc[Sa[q]] = (_Tp)(lambda*s[q]);
+            }
+            if (p_h < 0) {
+                return beta;    //least squares on Sa, nothing left to enter
+            }
+            //the path goes on as after k steps from a cold start, k atoms active
+            entering.push_back(p_h);
+            i = k;
+        } else {
+            Sa.clear();
+            active.assign(n, 0);
+            L = chol_factor(cap);
+        }
+    }
+
+    //the atoms with the max correlation enter first
+    if (Sa.empty()) {
+        double c_m = 0;
+        for (int j=0; j<n; j++) {
+            c_m = std::max(c_m, (double)fabs(pc[j]));
+        }
+        for (int j=0; j<n; j++) {
+            if (fabs(pc[j]) == c_m) {
+                entering.push_back(j);
+            }
+        }
+    }
+
+    Mat Ua(m, 1, TRACKIMG_TYPE(_Tp,1));
+    Mat a;
+    _Tp* pUa = Ua.ptr<_Tp>(0);
+    for (;;) {
+        enter();
+
+        if (!(i<=nu && norm(yr)>err)) {
+            break;
+        }
+        i++;
+        int k = (int)Sa.size();
+
+        //=== equiangular direction: w = Ga^-1*sign(c(Sa)), Aa = (s'w)^-1/2, Ua = Aa*Xa*w ===
+        for (int q=0; q<k; q++) {
+            s[q] = pc[Sa[q]] < 0 ? -1 : 1;
+        }
+        L.solve(&s[0], &w[0]);
+        double sw = 0;
+        for (int q=0; q<k; q++) {
+            sw += s[q]*w[q];
+        }
+        double Aa = 1/sqrt(sw);
+        double C = s[0]*pc[Sa[0]];
+        for (int r=0; r<m; r++) {
+            pUa[r] = 0;
+        }
+        for (int q=0; q<k; q++) {
+            const _Tp* xq = Xa.ptr<_Tp>(q);
+            _Tp wq = (_Tp)(Aa*w[q]);
+            for (int r=0; r<m; r++) {
+                pUa[r] += wq*xq[r];
+            }
+        }
+
+        /*============ LOOP EXIT WHEN SEARCHING REACH TO THE END ELEMENT OF DICTIONARY =============*/
+        if (i==n)
+        {
+            double r_h = Ua.dot(yr);
+            for (int q=0; q<k; q++) {
+                pbeta[Sa[q]] += (_Tp)(r_h*Aa*w[q]);
+            }
+            return beta;
+        }
+
+        //=== step gamma to the next atom entering the active set ===
+        linalg_gemm<_Tp>(X, Ua, a, GEMM_1_T);
+        const _Tp* pa = a.ptr<_Tp>(0);
+        double r_h = numeric_limits<double>::infinity();
+        int p_h = -1;
+        for (int j=0; j<n; j++) {
+            if (active[j]) {
+                continue;
+            }
+            double v1 = (C - pc[j]) / (Aa - pa[j]);
+            double v2 = (C + pc[j]) / (Aa + pa[j]);
+            if (v1 > 0 && v1 < r_h) {
+                r_h = v1; p_h = j;
+            }
+            if (v2 > 0 && v2 < r_h) {
+                r_h = v2; p_h = j;
+            }
+        }
+        if (p_h < 0) {
+            break;  //no atom can enter anymore
+        }
+
+        //=== beta(Sa) += gamma*sign(c(Sa)).*Wa, yr -= gamma*Ua, c -= gamma*a ===
+        for (int q=0; q<k; q++) {
+            pbeta[Sa[q]] += (_Tp)(r_h*Aa*w[q]);
+        }
+        _Tp gamma = (_Tp)r_h;
+        for (int r=0; r<m; r++) {
+            pyr[r] -= gamma*pUa[r];
+        }
+        for (int j=0; j<n; j++) {
+            pc[j] -= gamma*pa[j];
+        }
+        entering.push_back(p_h);
+    }
+
+    return beta;
+}
+
+/*
+ * State of one LARS solve in Gram space, advanced one step at a time.
+ */
+template<typename _Tp>
+class lars_gram_state
+{
+public:
+    lars_gram_state(const Mat& G, const Mat& b, double yy, double err, double nu, const Mat& beta0 = Mat()) :
+        m_G(G), m_err2(err*err), m_nu(nu), m_n(G.rows), m_i(0), m_rr(yy), m_done(false),
+        m_c(G.rows), m_beta(G.rows, 0.0), m_active(G.rows, 0), m_L(std::min(G.rows, (int)nu+3))
+    {
+        for (int j=0; j<m_n; j++) {
+            m_c[j] = b.at<_Tp>(j, 0);
+        }
+        m_done = (m_n == 0);
+        if (!m_done && !beta0.empty() && warm(beta0)) {
+            return;
+        }
+        //the atoms with the max correlation enter first
+        double c_m = 0;
+        for (int j=0; j<m_n; j++) {
+            c_m = std::max(c_m, fabs(m_c[j]));
+        }
+        for (int j=0; j<m_n; j++) {
+            if (fabs(m_c[j]) == c_m) {
+                enter(j);
+            }
+        }
+    }
+
+    bool done() const { return m_done; }
+
+    void step()
+    {
+        if (m_done || !(m_i<=m_nu && m_rr>m_err2)) {
+            m_done = true;
+            return;
+        }
+        m_i++;
+        int k = (int)m_Sa.size();
+        vector<double> s(k), w(k);
+        for (int q=0; q<k; q++) {
+            s[q] = m_c[m_Sa[q]] < 0 ? -1 : 1;
+        }
+        m_L.solve(&s[0], &w[0]);
+        double sw = 0;
+        double cw = 0;          //Xa'yr = c(Sa), so yr'*Ua = Aa*w'*c(Sa)
+        for (int q=0; q<k; q++) {
+            sw += s[q]*w[q];
+            cw += w[q]*m_c[m_Sa[q]];
+        }
+        double Aa = 1/sqrt(sw);
+        double C = s[0]*m_c[m_Sa[0]];
+        double yrUa = Aa*cw;
+
+        /*============ LOOP EXIT WHEN SEARCHING REACH TO THE END ELEMENT OF DICTIONARY =============*/
+        if (m_i==m_n)
+        {
+            for (int q=0; q<k; q++) {
+                m_beta[m_Sa[q]] += yrUa*Aa*w[q];
+            }
+            m_done = true;
+            return;
+        }
+
+        //a = X'*Ua = Aa*G(:,Sa)*w, G being symmetric its rows are used
+        vector<double> a(m_n, 0.0);
+        for (int q=0; q<k; q++) {
+            const _Tp* Gq = m_G.ptr<_Tp>(m_Sa[q]);
+            double wq = Aa*w[q];
+            for (int j=0; j<m_n; j++) {
+                a[j] += wq*Gq[j];
+            }
+        }
+        double r_h = numeric_limits<double>::infinity();
+        int p_h = -1;
+        for (int j=0; j<m_n; j++) {
+            if (m_active[j]) {
+                continue;
+            }
+            double v1 = (C - m_c[j]) / (Aa - a[j]);
+            double v2 = (C + m_c[j]) / (Aa + a[j]);
+            if (v1 > 0 && v1 < r_h) {
+                r_h = v1; p_h = j;
+            }
+            if (v2 > 0 && v2 < r_h) {
+                r_h = v2; p_h = j;
+            }
+        }
+        if (p_h < 0) {
+            m_done = true;
+            return;
+        }
+
+        //||Ua||^2 = Aa^2*w'*Ga*w with the Gram matrix of the active set
+        double UaUa = 0;
+        for (int q=0; q<k; q++) {
+            const _Tp* Gq = m_G.ptr<_Tp>(m_Sa[q]);
+            double v = 0;
+            for (int p=0; p<k; p++) {
+                v += Gq[m_Sa[p]]*w[p];
+            }
+            UaUa += w[q]*v;
+        }
+        UaUa *= Aa*Aa;
+
+        for (int q=0; q<k; q++) {
+            m_beta[m_Sa[q]] += r_h*Aa*w[q];
+        }
+        for (int j=0; j<m_n; j++) {
+            m_c[j] -= r_h*a[j];
+        }
+        m_rr = std::max(0.0, m_rr - 2*r_h*yrUa + r_h*r_h*UaUa);
+        enter(p_h);
+    }
+
+    void copyTo(Mat beta) const
+    {
+        for (int j=0; j<m_n; j++) {
+            beta.at<_Tp>(j, 0) = (_Tp)m_beta[j];
+        }
+    }
+
+private:
+    //start on the path at the active set of beta0, as lars_chol, false when it is off the path
+    bool warm(const Mat& beta0)
+    {
+        vector<int> Sa = lars_warm_atoms<_Tp>(beta0, m_nu);
+        int k = (int)Sa.size();
+        if (k == 0) {
+            return false;
+        }
+        for (int q=0; q<k; q++) {
+            enter(Sa[q]);
+        }
+        //m_c still holds b = X'*y
+        vector<double> s(k), ya(k), u(k), w(k);
+        for (int q=0; q<k; q++) {
+            s[q] = beta0.at<_Tp>(m_Sa[q], 0) < 0 ? -1 : 1;
+            ya[q] = m_c[m_Sa[q]];
+        }
+        m_L.solve(&ya[0], &u[0]);
+        m_L.solve(&s[0], &w[0]);
+        vector<double> c0(m_c), d(m_n, 0.0);
+        for (int q=0; q<k; q++) {
+            const _Tp* Gq = m_G.ptr<_Tp>(m_Sa[q]);
+            for (int j=0; j<m_n; j++) {
+                c0[j] -= u[q]*Gq[j];
+                d[j] += w[q]*Gq[j];
+            }
+        }
+        int p_h;
+        double lambda = lars_warm_lambda(c0, d, m_active, p_h);
+        if (lambda < 0) {
+            m_Sa.clear();
+            m_active.assign(m_n, 0);
+            m_L = chol_factor(std::min(m_n, (int)m_nu+3));
+            return false;
+        }
+        //||y-Xa*beta||^2 = yy - beta'*b(Sa) - lambda*beta'*s, as Ga*beta = b(Sa) - lambda*s
+        for (int q=0; q<k; q++) {
+            double bq = u[q] - lambda*w[q];
+            m_beta[m_Sa[q]] = bq;
+            m_rr -= bq*ya[q] + lambda*bq*s[q];
+        }
+        m_rr = std::max(0.0, m_rr);
+        for (int j=0; j<m_n; j++) {
+            m_c[j] = c0[j] + lambda*d[j];
+        }
+        for (int q=0; q<k; q++) {
+            m_c[m_Sa[q]] = lambda*s[q];
+        }
+        //the path goes on as after k steps from a cold start, k atoms active
+        m_i = k;
+        if (p_h < 0) {
+            m_done = true;  //least squares on Sa, nothing left to enter
+        } else {
+            enter(p_h);
+        }
+        return true;
+    }
+
+    void enter(int j)
+    {
+        int k = (int)m_Sa.size();
+        vector<double> g(k+1);
+        const _Tp* Gj = m_G.ptr<_Tp>(j);
+        for (int q=0; q<k; q++) {
+            g[q] = Gj[m_Sa[q]];
+        }
+        m_L.append(&g[0], Gj[j]);
+        m_Sa.push_back(j);
+        m_active[j] = 1;
+    }
+
+    const Mat& m_G;
+    double m_err2;
+    double m_nu;
+    int m_n;
+    int m_i;
+    double m_rr;            //squared norm of the residual
+    bool m_done;
+    vector<double> m_c;     //correlations X'*yr
+    vector<double> m_beta;
+    vector<char> m_active;
+    vector<int> m_Sa;
+    chol_factor m_L;
+};
+
+template<typename _Tp>
+Mat lars_gram(Mat G, Mat b, double yy, double err, double nu, Mat beta0)
+{
+    Mat beta(G.rows, 1, TRACKIMG_TYPE(_Tp,1));
+    lars_gram_state<_Tp> st(G, b, yy, err, nu, beta0);
+    while (!st.done()) {
+        st.step();
+    }
+    st.copyTo(beta);
+    return beta;
+}
+
+bool lars_gram_pays_off(int n, int k, double nu)
+{
+    //X'*X costs n*n/2 dot products, k lars_chol runs about k*(nu+1)*n
+    return n < 2*k*(nu+1);
+}
+
+template Mat lars_chol<float>(Mat y, Mat X, double err, double nu, Mat beta0);
+template Mat lars_chol<double>(Mat y, Mat X, double err, double nu, Mat beta0);
+template Mat lars_gram<float>(Mat G, Mat b, double yy, double err, double nu, Mat beta0);
+template Mat lars_gram<double>(Mat G, Mat b, double yy, double err, double nu, Mat beta0);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * @author Weizhi Liu (MatLab version of the Algorithm)
+ * @author Giang Truong Nguyen (C/C++ version of the Algorithm)
+ *
+ * Maintainers :
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+#ifndef _TRACKIMG_LARS_H_
+#define _TRACKIMG_LARS_H_
+
+#include "opencv2/core/core.hpp"
+
+using namespace cv;
+
+/* LARS solvers used by Rec_Lasso */
+typedef enum {
+    LARS_SOLVER_REFERENCE = 0,  /* lars_lu, Gram matrix rebuilt and inverted at each step */
+    LARS_SOLVER_CHOLESKY,       /* lars_chol, incremental Cholesky factor of the Gram matrix */
+    LARS_SOLVER_GRAM,           /* lars_gram on the shared X'*X when it pays off, lars_chol otherwise */
+    LARS_SOLVER_SIZE /* only used for range check */
+} lars_solver_et;
+
+/*
+ * Coefficients of a warm start below this ratio of the largest one are not
+ * seeded: the atoms of the noise differ from one problem to the next and
+ * would hold the path at a worse fit.
+ */
+#define TRACKIMG_LARS_WARM_RATIO 0.05
+
+/**
+ * LARS on dictionary X (one atom per column) for the vector y, at most nu+1
+ * steps or until the residual norm falls under err. Follows the same path
+ * as lars_lu and returns the n*1 coefficient vector beta, but keeps a
+ * Cholesky factor of the active Gram matrix updated by one row per new
+ * atom, and updates the residual and the correlations along the step
+ * direction Ua instead of recomputing y-X*beta and X'*yr.
+ *
+ * With beta0 (n*1, a solution for a nearby y), the path starts where the
+ * atoms of its significant coefficients, with their signs, are the active
+ * set: the coefficients there are solved in one go and only the steps
+ * after it are run. When these atoms cannot all be active at once for y,
+ * it starts from beta = 0 as without beta0.
+ */
+template<typename _Tp>
+Mat lars_chol(Mat y, Mat X, double err, double nu, Mat beta0 = Mat());
+
+/**
+ * Same as lars_chol, but entirely in Gram space: G = X'*X (n*n), b = X'*y
+ * (n*1) and yy = y'*y are all the solver needs. Each step costs O(n*k)
+ * for k active atoms instead of O(m*n). beta0 warm starts it as in
+ * lars_chol.
+ */
+template<typename _Tp>
+Mat lars_gram(Mat G, Mat b, double yy, double err, double nu, Mat beta0 = Mat());
+
+/**
+ * True when precomputing X'*X for k right-hand sides on a dictionary of
+ * n atoms costs less than the products of k lars_chol runs.
+ */
+bool lars_gram_pays_off(int n, int k, double nu);
+
+#endif  /* _TRACKIMG_LARS_H_ */
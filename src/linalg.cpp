@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <algorithm>
+#include <omp.h>
+#ifdef TRACKIMG_HAVE_EIGEN
+#include <Eigen/Dense>
+#endif
+#ifdef TRACKIMG_HAVE_BLAS
+extern "C" {
+#include <cblas.h>
+}
+#endif
+
+#include "tracker.h"
+#include "linalg.h"
+
+using namespace std;
+
+/* lanes of the accumulators of the dot kernel, a multiple of the SIMD width */
+#define LINALG_LANES 8
+
+static int linalg_current = TRACKIMG_LINALG_DEFAULT;
+
+static const char* linalg_names[LINALG_SIZE] = {
+    "opencv",
+    "blocked",
+    "eigen",
+    "blas"
+};
+
+bool linalg_available(int backend)
+{
+    switch (backend) {
+    case LINALG_OPENCV:
+    case LINALG_BLOCKED:
+        return true;
+#ifdef TRACKIMG_HAVE_EIGEN
+    case LINALG_EIGEN:
+        return true;
+#endif
+#ifdef TRACKIMG_HAVE_BLAS
+    case LINALG_BLAS:
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* linalg_name(int backend)
+{
+    return (backend >= 0 && backend < LINALG_SIZE) ? linalg_names[backend] : "unknown";
+}
+
+bool linalg_set_backend(int backend)
+{
+    if (!linalg_available(backend)) {
+        return false;
+    }
+    linalg_current = backend;
+    return true;
+}
+
+int linalg_backend()
+{
+    return linalg_current;
+}
+
+/*
+ * C(i0..i1, j0..j1) += A rows i0..i1 . B rows j0..j1, 4x2 results at a
+ * time over blocks of TRACKIMG_LINALG_KC columns. The partial sums are kept
+ * lane by lane so that the inner loop vectorizes without reassociation;
+ * the rows past the end of a tile are read again and their sums dropped.
+ */
+template<typename _Tp>
+static void gemm_nt_tile(const Mat& A, const Mat& B, Mat& C, int i0, int i1, int j0, int j1)
+{
+    int K = A.cols;
+    for (int k0=0; k0<K; k0+=TRACKIMG_LINALG_KC) {
+        int kc = std::min(TRACKIMG_LINALG_KC, K-k0);
+        int kv = kc - kc%LINALG_LANES;
+        for (int i=i0; i<i1; i+=4) {
+            int mi = std::min(4, i1-i);
+            const _Tp* a[4];
+            for (int ii=0; ii<4; ii++) {
+                a[ii] = A.ptr<_Tp>(i + std::min(ii, mi-1)) + k0;
+            }
+            for (int j=j0; j<j1; j+=2) {
+                int nj = std::min(2, j1-j);
+                const _Tp* b[2];
+                for (int jj=0; jj<2; jj++) {
+                    b[jj] = B.ptr<_Tp>(j + std::min(jj, nj-1)) + k0;
+                }
+                _Tp acc[4][2][LINALG_LANES] = {};
+                const _Tp *a0 = a[0], *a1 = a[1], *a2 = a[2], *a3 = a[3];
+                const _Tp *b0 = b[0], *b1 = b[1];
+                for (int k=0; k<kv; k+=LINALG_LANES) {
+                    //one loop over the lanes for the compiler to vectorize
+                    for (int l=0; l<LINALG_LANES; l++) {
+                        _Tp x0 = b0[k+l], x1 = b1[k+l];
+                        acc[0][0][l] += a0[k+l]*x0;
+                        acc[0][1][l] += a0[k+l]*x1;
+                        acc[1][0][l] += a1[k+l]*x0;
+                        acc[1][1][l] += a1[k+l]*x1;
+                        acc[2][0][l] += a2[k+l]*x0;
+                        acc[2][1][l] += a2[k+l]*x1;
+                        acc[3][0][l] += a3[k+l]*x0;
+                        acc[3][1][l] += a3[k+l]*x1;
+                    }
+                }
+                for (int ii=0; ii<mi; ii++) {
+                    _Tp* c = C.ptr<_Tp>(i+ii) + j;
+                    for (int jj=0; jj<nj; jj++) {
+                        _Tp s = 0;
+                        for (int l=0; l<LINALG_LANES; l++) {
+                            s += acc[ii][jj][l];
+                        }
+                        for (int k=kv; k<kc; k++) {
+                            s += a[ii][k]*b[jj][k];
+                        }
+                        c[jj] += s;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/* C = A*B', dot products of the rows of A and B, by tiles of C */
+template<typename _Tp>
+static void gemm_nt_blocked(const Mat& A, const Mat& B, Mat& C)
+{
+    int M = A.rows, N = B.rows;
+    C.setTo(Scalar(0));
+    int tilesI = (M + TRACKIMG_LINALG_MC - 1)/TRACKIMG_LINALG_MC;
+    int tilesJ = (N + TRACKIMG_LINALG_NC - 1)/TRACKIMG_LINALG_NC;
+    double work = (double)M*N*A.cols;
+    #pragma omp parallel for schedule(dynamic) if(work > TRACKIMG_LINALG_PARALLEL)
+    for (int t=0; t<tilesI*tilesJ; t++) {
+        int i0 = (t/tilesJ)*TRACKIMG_LINALG_MC;
+        int j0 = (t%tilesJ)*TRACKIMG_LINALG_NC;
+        gemm_nt_tile<_Tp>(A, B, C, i0, std::min(i0 + TRACKIMG_LINALG_MC, M), j0, std::min(j0 + TRACKIMG_LINALG_NC, N));
+    }
+}
+
+/*
+ * C = A'*B, with A of K*M and B of K*N, as K rank-one updates of every
+ * tile of C, the rows of the tile being updated with contiguous axpys.
+ */
+template<typename _Tp>
+static void gemm_tn_blocked(const Mat& A, const Mat& B, Mat& C)
+{
+    int K = A.rows, M = A.cols, N = B.cols;
+    C.setTo(Scalar(0));
+    int tilesI = (M + TRACKIMG_LINALG_MC - 1)/TRACKIMG_LINALG_MC;
+    int tilesJ = (N + TRACKIMG_LINALG_NC - 1)/TRACKIMG_LINALG_NC;
+    double work = (double)M*N*K;
+    #pragma omp parallel for schedule(dynamic) if(work > TRACKIMG_LINALG_PARALLEL)
+    for (int t=0; t<tilesI*tilesJ; t++) {
+        int i0 = (t/tilesJ)*TRACKIMG_LINALG_MC, i1 = std::min(i0 + TRACKIMG_LINALG_MC, M);
+        int j0 = (t%tilesJ)*TRACKIMG_LINALG_NC, j1 = std::min(j0 + TRACKIMG_LINALG_NC, N);
+        for (int k=0; k<K; k++) {
+            const _Tp* a = A.ptr<_Tp>(k);
+            const _Tp* b = B.ptr<_Tp>(k) + j0;
+            for (int i=i0; i<i1; i++) {
+                _Tp aki = a[i];
+                _Tp* c = C.ptr<_Tp>(i) + j0;
+                for (int j=0; j<j1-j0; j++) {
+                    c[j] += aki*b[j];
+                }
+            }
+        }
+    }
+}
+
+template<typename _Tp>
+static void gemm_blocked(const Mat& A, const Mat& B, Mat& C, int flags)
+{
+    bool t1 = (flags & GEMM_1_T) != 0;
+    bool t2 = (flags & GEMM_2_T) != 0;
+    if (t1 && !t2) {
+        if (C.cols >= C.rows) {
+            gemm_tn_blocked<_Tp>(A, B, C);
+        } else {
+            //the longer side in the axpys, X'*r is computed as (r'*X)'
+            Mat Ct(C.cols, C.rows, C.type());
+            gemm_tn_blocked<_Tp>(B, A, Ct);
+            transpose(Ct, C);
+        }
+    } else if (!t1 && t2) {
+        gemm_nt_blocked<_Tp>(A, B, C);
+    } else if (!t1) {
+        Mat Bt;
+        transpose(B, Bt);
+        gemm_nt_blocked<_Tp>(A, Bt, C);
+    } else {
+        Mat At;
+        transpose(A, At);
+        gemm_nt_blocked<_Tp>(At, B, C);
+    }
+}
+
+#ifdef TRACKIMG_HAVE_EIGEN
+template<typename _Tp>
+static void gemm_eigen(const Mat& A, const Mat& B, Mat& C, int flags)
+{
+    typedef Eigen::Matrix<_Tp, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> matrix;
+    typedef Eigen::Map<const matrix, 0, Eigen::OuterStride<> > const_map;
+    typedef Eigen::Map<matrix, 0, Eigen::OuterStride<> > map;
+    const_map a(A.ptr<_Tp>(), A.rows, A.cols, Eigen::OuterStride<>(A.step1()));
+    const_map b(B.ptr<_Tp>(), B.rows, B.cols, Eigen::OuterStride<>(B.step1()));
+    map c(C.ptr<_Tp>(), C.rows, C.cols, Eigen::OuterStride<>(C.step1()));
+    bool t1 = (flags & GEMM_1_T) != 0;
+    bool t2 = (flags & GEMM_2_T) != 0;
+    if (t1 && t2) {
+        c.noalias() = a.transpose()*b.transpose();
+    } else if (t1) {
+        c.noalias() = a.transpose()*b;
+    } else if (t2) {
+        c.noalias() = a*b.transpose();
+    } else {
+        c.noalias() = a*b;
+    }
+}
+#endif
+
+#ifdef TRACKIMG_HAVE_BLAS
+static void gemm_blas(CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, int M, int N, int K, const float* A, int lda, const float* B, int ldb, float* C, int ldc)
+{
+    cblas_sgemm(CblasRowMajor, ta, tb, M, N, K, 1.0f, A, lda, B, ldb, 0.0f, C, ldc);
+}
+
+static void gemm_blas(CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, int M, int N, int K, const double* A, int lda, const double* B, int ldb, double* C, int ldc)
+{
+    cblas_dgemm(CblasRowMajor, ta, tb, M, N, K, 1.0, A, lda, B, ldb, 0.0, C, ldc);
+}
+#endif
+
+template<typename _Tp>
+void linalg_gemm(const Mat& A, const Mat& B, Mat& C, int flags)
+{
+    if (linalg_current == LINALG_OPENCV) {
+        gemm(A, B, 1, Mat(), 0, C, flags);
+        return;
+    }
+    bool t1 = (flags & GEMM_1_T) != 0;
+    bool t2 = (flags & GEMM_2_T) != 0;
+    int M = t1 ? A.cols : A.rows;
+    int K = t1 ? A.rows : A.cols;
+    int N = t2 ? B.rows : B.cols;
+    C.create(M, N, TRACKIMG_TYPE(_Tp,1));
+    if (M == 0 || N == 0) {
+        return;
+    }
+    if (K == 0) {
+        C.setTo(Scalar(0));
+        return;
+    }
+    switch (linalg_current) {
+#ifdef TRACKIMG_HAVE_EIGEN
+    case LINALG_EIGEN:
+        gemm_eigen<_Tp>(A, B, C, flags);
+        break;
+#endif
+#ifdef TRACKIMG_HAVE_BLAS
+    case LINALG_BLAS:
+        gemm_blas(t1 ? CblasTrans : CblasNoTrans, t2 ? CblasTrans : CblasNoTrans, M, N, K,
+                  A.ptr<_Tp>(), (int)A.step1(), B.ptr<_Tp>(), (int)B.step1(), C.ptr<_Tp>(), (int)C.step1());
+        break;
+#endif
+    default:
+        gemm_blocked<_Tp>(A, B, C, flags);
+        break;
+    }
+}
+
+/* Explicit instantiations */
+template void linalg_gemm<float>(const Mat& A, const Mat& B, Mat& C, int flags);
+template void linalg_gemm<double>(const Mat& A, const Mat& B, Mat& C, int flags);
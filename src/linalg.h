@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_LINALG_H_
+#define _TRACKIMG_LINALG_H_
+
+#include "opencv2/core/core.hpp"
+
+using namespace cv;
+
+/* Implementations of the dense matrix products of the solver */
+typedef enum {
+    LINALG_OPENCV = 0,  /* cv::gemm, reference */
+    LINALG_BLOCKED,     /* in-tree cache-blocked kernels, OpenMP, fallback without Eigen or BLAS */
+    LINALG_EIGEN,       /* Eigen, built with TRACKIMG_HAVE_EIGEN */
+    LINALG_BLAS,        /* system CBLAS, built with TRACKIMG_HAVE_BLAS */
+    LINALG_SIZE
+} linalg_et;
+
+/* backend chosen at configure time, TRACKIMG_LINALG in CMake */
+#ifndef TRACKIMG_LINALG_DEFAULT
+#define TRACKIMG_LINALG_DEFAULT LINALG_OPENCV
+#endif
+
+/* inner dimension of a block of the blocked kernels */
+#define TRACKIMG_LINALG_KC 256
+/* rows and columns of a tile of the result of the blocked kernels */
+#define TRACKIMG_LINALG_MC 32
+#define TRACKIMG_LINALG_NC 64
+/* multiply-adds below which the blocked kernels run on one thread */
+#define TRACKIMG_LINALG_PARALLEL (1 << 18)
+
+bool linalg_available(int backend);
+const char* linalg_name(int backend);
+
+/* to call before the tracking threads start, false if not built in */
+bool linalg_set_backend(int backend);
+int linalg_backend();
+
+/**
+ * C = op(A)*op(B) with the current backend, op transposing A and B as
+ * GEMM_1_T and GEMM_2_T in flags, like cv::gemm(A, B, 1, Mat(), 0, C,
+ * flags). A and B are _Tp matrices with one channel.
+ *
+ * The shapes of the solver are short-wide times tall: the projection
+ * P*D' of the dictionary (GEMM_2_T), the correlations X'*r and the Gram
+ * matrices Dc'*Dc (GEMM_1_T).
+ */
+template<typename _Tp>
+void linalg_gemm(const Mat& A, const Mat& B, Mat& C, int flags);
+
+#endif  /* _TRACKIMG_LINALG_H_ */
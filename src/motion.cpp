@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "motion.h"
+
+using namespace std;
+using namespace cv;
+
+motion_filter::motion_filter() :
+    m_kf(4, 2, 0, CV_64F)
+{
+    //state (x, y, vx, vy), one frame per step
+    m_kf.transitionMatrix = Mat::eye(4, 4, CV_64F);
+    m_kf.transitionMatrix.at<double>(0,2) = 1;
+    m_kf.transitionMatrix.at<double>(1,3) = 1;
+    m_kf.measurementMatrix = Mat::eye(2, 4, CV_64F);
+
+    //white noise acceleration: the position moves by a/2, the speed by a
+    double q = TRACKIMG_MOTION_ACCELERATION*TRACKIMG_MOTION_ACCELERATION;
+    m_kf.processNoiseCov = Mat::zeros(4, 4, CV_64F);
+    for (int i=0; i<2; i++)
+    {
+        m_kf.processNoiseCov.at<double>(i,i) = q/4;
+        m_kf.processNoiseCov.at<double>(i,i+2) = q/2;
+        m_kf.processNoiseCov.at<double>(i+2,i) = q/2;
+        m_kf.processNoiseCov.at<double>(i+2,i+2) = q;
+    }
+    m_kf.measurementNoiseCov = Mat::eye(2, 2, CV_64F)*(TRACKIMG_MOTION_MEASUREMENT*TRACKIMG_MOTION_MEASUREMENT);
+}
+
+void motion_filter::init(Mat p)
+{
+    m_kf.statePost = Mat::zeros(4, 1, CV_64F);
+    m_kf.statePost.at<double>(0,0) = p.at<double>(0,0);
+    m_kf.statePost.at<double>(1,0) = p.at<double>(1,0);
+    m_kf.errorCovPost = Mat::zeros(4, 4, CV_64F);
+    for (int i=0; i<2; i++)
+    {
+        m_kf.errorCovPost.at<double>(i,i) = TRACKIMG_MOTION_MEASUREMENT*TRACKIMG_MOTION_MEASUREMENT;
+        m_kf.errorCovPost.at<double>(i+2,i+2) = TRACKIMG_MOTION_SPEED*TRACKIMG_MOTION_SPEED;
+    }
+    m_kf.statePost.copyTo(m_kf.statePre);
+    m_kf.errorCovPost.copyTo(m_kf.errorCovPre);
+}
+
+void motion_filter::predict()
+{
+    //also copies the prediction to the posterior, so a frame without a
+    //detection just predicts from it again
+    m_kf.predict();
+}
+
+void motion_filter::correct(Mat p)
+{
+    Mat z(2, 1, CV_64F);
+    z.at<double>(0,0) = p.at<double>(0,0);
+    z.at<double>(1,0) = p.at<double>(1,0);
+    m_kf.correct(z);
+}
+
+Mat motion_filter::position()
+{
+    return m_kf.statePre.rowRange(0, 2).clone();
+}
+
+Mat motion_filter::regionScale(Mat sz, double gate, Mat step, Mat maxScale)
+{
+    Mat sc(2, 1, CV_64F);
+    for (int i=0; i<2; i++)
+    {
+        double margin = std::max(gate*sqrt(m_kf.errorCovPre.at<double>(i,i)), step.at<double>(i,0));
+        double s = sz.at<double>(i,0);
+        sc.at<double>(i,0) = std::min((s + 2*margin)/s, maxScale.at<double>(i,0));
+    }
+    return sc;
+}
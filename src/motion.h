@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_MOTION_H_
+#define _TRACKIMG_MOTION_H_
+
+#include "opencv2/core/core.hpp"
+#include "opencv2/video/tracking.hpp"
+
+using namespace cv;
+
+/* std of the acceleration of the object, pixels per frame^2 */
+#define TRACKIMG_MOTION_ACCELERATION 2.0
+/* std of a detected position, the sliding windows are 4 pixels apart */
+#define TRACKIMG_MOTION_MEASUREMENT 2.0
+/* std of the speed before the first detection, pixels per frame */
+#define TRACKIMG_MOTION_SPEED 8.0
+
+/*
+ * Constant velocity Kalman filter over the top-left position of a target,
+ * one predict() per frame and one correct() per verified detection.
+ *
+ * The predicted position centres the search region and the predicted
+ * covariance sizes it per axis: while the detections follow the model the
+ * region shrinks towards the object, while the target is lost it grows
+ * with every predict().
+ */
+class motion_filter
+{
+public:
+    motion_filter();
+
+    /* start at position p (x, y), still, with an unknown speed */
+    void init(Mat p);
+    void predict();
+    void correct(Mat p);
+
+    /* predicted position (x, y), as a 2x1 CV_64F */
+    Mat position();
+
+    /**
+     * Scales of the search region (x, y), as a 2x1 CV_64F, for an object
+     * of size sz: the object plus <gate> std of the predicted position on
+     * every side, at least <step> pixels, clipped to maxScale.
+     */
+    Mat regionScale(Mat sz, double gate, Mat step, Mat maxScale);
+
+private:
+    KalmanFilter m_kf;
+};
+
+#endif  /* _TRACKIMG_MOTION_H_ */
@@ -31,28 +31,111 @@
  */
 
 #include <iostream>
+#include <stdio.h>
+#include <time.h>
+#include <ctype.h>
 #include <omp.h>
 
 #include "trackimg.h"
 #include "options.h"
 #include "trace.h"
+#include "tracker.h"
+#include "lars.h"
+#include "projection.h"
+#include "feature.h"
 
 options::options() {
     m_nbProcessors = 1;
     m_verboseLevel = TRACKIMG_VL_QUIET;
     m_inputDirectory = "./animal/";
-    m_objPos[0] = 153;
-    m_objPos[1] = 4;
-    m_objSize[0] = 41;
-    m_objSize[1] = 30;
+    m_headless = false;
+    m_prefetchDepth = 2;
+    m_precision = 32;
+    m_larsSolver = LARS_SOLVER_GRAM;
+    m_projection = PROJECTION_GAUSSIAN;
+    m_seed = (unsigned int)time(NULL);
+    m_framePattern = "%d.jpg";
+    m_firstFrame = 1;
+    m_lastFrame = -1;
+    m_jobs = 1;
+    m_statsPeriod = 0;
+    m_tolerance = 0.02;
+    m_coarseFactor = 1;
+    m_motionGate = 0;
+    m_feature = FEATURE_PIXELS;
+    m_update = UPDATE_ALWAYS;
+    m_backgroundUpdate = UPDATE_ALWAYS;
+    m_updatePeriod = 5;
+    m_screening = SCREEN_NONE;
+    m_screenKeep = 64;
+    m_warmStart = false;
 }
 
 void options::print(){
     if (m_verboseLevel != TRACKIMG_VL_QUIET) {
         cout << "Options are :" << endl;
-        cout << "   + Video dataset        : " << m_inputDirectory << endl;
+        if (!m_batch.empty()) {
+            cout << "   + Batch                : " << m_batch << " (" << m_jobs << " at once)" << endl;
+        } else if (m_inputVideo.empty()) {
+            cout << "   + Video dataset        : " << m_inputDirectory << "/" << m_framePattern << endl;
+        } else {
+            cout << "   + Video file           : " << m_inputVideo << endl;
+        }
+        cout << "   + Frames               : " << m_firstFrame << " to ";
+        if (m_lastFrame < 0) {
+            cout << "end" << endl;
+        } else {
+            cout << m_lastFrame << endl;
+        }
         cout << "   + Number of processors : " << m_nbProcessors << " (Max processors: " << omp_get_num_procs() << ")" << endl;
         cout << "   + Verbosity level      : " << m_verboseLevel << endl;
+        cout << "   + Display              : " << (m_headless ? "off (headless)" : "on") << endl;
+        cout << "   + Prefetch depth       : " << m_prefetchDepth << endl;
+        cout << "   + Precision            : " << (m_precision == 64 ? "double" : "float") << endl;
+        cout << "   + LARS solver          : " << m_larsSolver << endl;
+        cout << "   + Random projection    : " << m_projection << endl;
+        cout << "   + Features             : " << m_feature << endl;
+        cout << "   + Model updates        : templates " << m_update << ", background " << m_backgroundUpdate;
+        if (m_update == UPDATE_PERIOD || m_backgroundUpdate == UPDATE_PERIOD) {
+            cout << " (every " << m_updatePeriod << " frames)";
+        }
+        cout << endl;
+        cout << "   + Motion filter        : ";
+        if (m_motionGate > 0) {
+            cout << "region of " << m_motionGate << " std" << endl;
+        } else {
+            cout << "off" << endl;
+        }
+        cout << "   + Screening            : ";
+        if (m_screening == SCREEN_STRONG) {
+            cout << "strong rule" << endl;
+        } else if (m_screening == SCREEN_TOPK) {
+            cout << m_screenKeep << " windows" << endl;
+        } else {
+            cout << "off" << endl;
+        }
+        cout << "   + LARS warm start      : " << (m_warmStart ? "on" : "off") << endl;
+        cout << "   + Coarse search        : " << (m_coarseFactor > 1 ? "1/" + to_string(m_coarseFactor) : string("off")) << endl;
+        cout << "   + Seed                 : " << m_seed << endl;
+        cout << "   + Targets              : ";
+        if (m_objPos.empty()) {
+            cout << "example box" << endl;
+        } else {
+            for (size_t i=0; i<m_objPos.size()/2; i++) {
+                cout << (i ? " " : "") << m_objPos[2*i] << "," << m_objPos[2*i+1] << "," << m_objSize[2*i] << "," << m_objSize[2*i+1];
+            }
+            cout << endl;
+        }
+        cout << "   + Stage statistics     : " << (m_statsFile.empty() ? "off" : m_statsFile);
+        if (!m_statsFile.empty() && m_statsPeriod > 0) {
+            cout << " (every " << m_statsPeriod << " frames)";
+        }
+        cout << endl;
+        cout << "   + Ground truth         : " << (m_groundtruth.empty() ? "none" : m_groundtruth) << endl;
+        if (!m_baseline.empty()) {
+            cout << "   + Baseline             : " << m_baseline << " (tolerance " << m_tolerance << ")" << endl;
+        }
+        cout << "   + Trajectory file      : " << (m_trajectoryFile.empty() ? "none" : m_trajectoryFile) << endl;
     }
 }
 
@@ -76,10 +159,124 @@ void options::setVerboseLevel(char* arg_value){
 
 void options::setInputDirectory(string arg_value){
     m_inputDirectory = arg_value;
-    m_objPos[0] = 0;
-    m_objPos[1] = 0;
-    m_objSize[0] = 0;
-    m_objSize[1] = 0;
+}
+
+void options::setHeadless(bool arg_value){
+    m_headless = arg_value;
+}
+
+void options::setPrefetchDepth(int arg_value){
+    if (arg_value < 0) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_PREFETCH);
+        exit(TRACKIMG_ERR_BAD_ARGS_PREFETCH);
+    }
+    m_prefetchDepth = arg_value;
+}
+
+void options::setPrecision(int arg_value){
+    if (arg_value != 32 && arg_value != 64) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_PRECISION);
+        exit(TRACKIMG_ERR_BAD_ARGS_PRECISION);
+    }
+    m_precision = arg_value;
+}
+
+void options::setLarsSolver(int arg_value){
+    if (arg_value < 0 || arg_value >= LARS_SOLVER_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_SOLVER);
+        exit(TRACKIMG_ERR_BAD_ARGS_SOLVER);
+    }
+    m_larsSolver = arg_value;
+}
+
+void options::setProjection(int arg_value){
+    if (arg_value < 0 || arg_value >= PROJECTION_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_PROJECTION);
+        exit(TRACKIMG_ERR_BAD_ARGS_PROJECTION);
+    }
+    m_projection = arg_value;
+}
+
+void options::setSeed(unsigned int arg_value){
+    m_seed = arg_value;
+}
+
+void options::setTrajectoryFile(string arg_value){
+    m_trajectoryFile = arg_value;
+}
+
+void options::setInputVideo(string arg_value){
+    m_inputVideo = arg_value;
+}
+
+void options::setFramePattern(string arg_value){
+    //exactly one integer conversion, the frame index
+    int conversions = 0;
+    for (size_t i=0; i<arg_value.size(); i++) {
+        if (arg_value[i] != '%') {
+            continue;
+        }
+        i++;
+        if (i < arg_value.size() && arg_value[i] == '%') {
+            continue;
+        }
+        while (i < arg_value.size() && (arg_value[i] == '0' || arg_value[i] == '-' || arg_value[i] == '+' || arg_value[i] == ' ' || isdigit(arg_value[i]))) {
+            i++;
+        }
+        if (i >= arg_value.size() || (arg_value[i] != 'd' && arg_value[i] != 'i' && arg_value[i] != 'u')) {
+            conversions = -1;
+            break;
+        }
+        conversions++;
+    }
+    if (conversions != 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_PATTERN);
+        exit(TRACKIMG_ERR_BAD_ARGS_PATTERN);
+    }
+    m_framePattern = arg_value;
+}
+
+void options::setFirstFrame(int arg_value){
+    if (arg_value < 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_RANGE);
+        exit(TRACKIMG_ERR_BAD_ARGS_RANGE);
+    }
+    m_firstFrame = arg_value;
+}
+
+void options::setLastFrame(int arg_value){
+    m_lastFrame = arg_value;
+}
+
+void options::addTarget(string arg_value){
+    int x, y, w, h;
+    char end;
+    if (sscanf(arg_value.c_str(), "%d,%d,%d,%d%c", &x, &y, &w, &h, &end) != 4 || x < 0 || y < 0 || w <= 0 || h <= 0) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_TARGET);
+        exit(TRACKIMG_ERR_BAD_ARGS_TARGET);
+    }
+    m_objPos.push_back(x);
+    m_objPos.push_back(y);
+    m_objSize.push_back(w);
+    m_objSize.push_back(h);
+}
+
+void options::clearTargets(){
+    m_objPos.clear();
+    m_objSize.clear();
+}
+
+void options::setBatch(string arg_value){
+    m_batch = arg_value;
+    m_headless = true;  //no window per sequence
+}
+
+void options::setJobs(int arg_value){
+    if (arg_value < 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_JOBS);
+        exit(TRACKIMG_ERR_BAD_ARGS_JOBS);
+    }
+    m_jobs = arg_value;
 }
 
 int options::getNbProcessors() {
@@ -94,10 +291,218 @@ string options::getInputDirectory() {
     return m_inputDirectory;
 }
 
-int options::getObjtPos(int i) {
-    return m_objPos[i];
+bool options::isHeadless() {
+    return m_headless;
+}
+
+int options::getPrefetchDepth() {
+    return m_prefetchDepth;
+}
+
+int options::getPrecision() {
+    return m_precision;
+}
+
+int options::getLarsSolver() {
+    return m_larsSolver;
+}
+
+int options::getProjection() {
+    return m_projection;
+}
+
+unsigned int options::getSeed() {
+    return m_seed;
+}
+
+string options::getTrajectoryFile() {
+    return m_trajectoryFile;
+}
+
+string options::getInputVideo() {
+    return m_inputVideo;
+}
+
+string options::getFramePattern() {
+    return m_framePattern;
+}
+
+int options::getFirstFrame() {
+    return m_firstFrame;
+}
+
+int options::getLastFrame() {
+    return m_lastFrame;
+}
+
+string options::getBatch() {
+    return m_batch;
+}
+
+int options::getJobs() {
+    return m_jobs;
+}
+
+void options::setStatsFile(string arg_value){
+    m_statsFile = arg_value;
+}
+
+void options::setStatsPeriod(int arg_value){
+    if (arg_value < 0) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_STATS);
+        exit(TRACKIMG_ERR_BAD_ARGS_STATS);
+    }
+    m_statsPeriod = arg_value;
+}
+
+void options::setGroundtruth(string arg_value){
+    m_groundtruth = arg_value;
+}
+
+void options::setBaseline(string arg_value){
+    m_baseline = arg_value;
+}
+
+void options::setTolerance(double arg_value){
+    if (arg_value < 0 || arg_value > 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_TOLERANCE);
+        exit(TRACKIMG_ERR_BAD_ARGS_TOLERANCE);
+    }
+    m_tolerance = arg_value;
+}
+
+string options::getGroundtruth() {
+    return m_groundtruth;
+}
+
+string options::getBaseline() {
+    return m_baseline;
+}
+
+double options::getTolerance() {
+    return m_tolerance;
+}
+
+void options::setCoarseFactor(int arg_value){
+    if (arg_value < 1 || arg_value > 8) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_COARSE);
+        exit(TRACKIMG_ERR_BAD_ARGS_COARSE);
+    }
+    m_coarseFactor = arg_value;
+}
+
+int options::getCoarseFactor() {
+    return m_coarseFactor;
+}
+
+void options::setMotionGate(double arg_value){
+    if (arg_value < 0 || arg_value > 10) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_MOTION);
+        exit(TRACKIMG_ERR_BAD_ARGS_MOTION);
+    }
+    m_motionGate = arg_value;
+}
+
+double options::getMotionGate() {
+    return m_motionGate;
+}
+
+void options::setFeature(int arg_value){
+    if (arg_value < 0 || arg_value >= FEATURE_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_FEATURE);
+        exit(TRACKIMG_ERR_BAD_ARGS_FEATURE);
+    }
+    m_feature = arg_value;
+}
+
+int options::getFeature() {
+    return m_feature;
+}
+
+void options::setUpdate(int arg_value){
+    if (arg_value < 0 || arg_value >= UPDATE_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+        exit(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+    }
+    m_update = arg_value;
+}
+
+void options::setBackgroundUpdate(int arg_value){
+    if (arg_value < 0 || arg_value >= UPDATE_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+        exit(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+    }
+    m_backgroundUpdate = arg_value;
+}
+
+void options::setUpdatePeriod(int arg_value){
+    if (arg_value < 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+        exit(TRACKIMG_ERR_BAD_ARGS_UPDATE);
+    }
+    m_updatePeriod = arg_value;
+}
+
+int options::getUpdate() {
+    return m_update;
+}
+
+int options::getBackgroundUpdate() {
+    return m_backgroundUpdate;
+}
+
+int options::getUpdatePeriod() {
+    return m_updatePeriod;
+}
+
+void options::setScreening(int arg_value){
+    if (arg_value < 0 || arg_value >= SCREEN_SIZE) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_SCREEN);
+        exit(TRACKIMG_ERR_BAD_ARGS_SCREEN);
+    }
+    m_screening = arg_value;
+}
+
+void options::setScreenKeep(int arg_value){
+    if (arg_value < 1) {
+        print_trackimg_error(TRACKIMG_ERR_BAD_ARGS_SCREEN);
+        exit(TRACKIMG_ERR_BAD_ARGS_SCREEN);
+    }
+    m_screenKeep = arg_value;
+}
+
+int options::getScreening() {
+    return m_screening;
+}
+
+int options::getScreenKeep() {
+    return m_screenKeep;
+}
+
+void options::setWarmStart(bool arg_value){
+    m_warmStart = arg_value;
+}
+
+bool options::isWarmStart() {
+    return m_warmStart;
+}
+
+string options::getStatsFile() {
+    return m_statsFile;
+}
+
+int options::getStatsPeriod() {
+    return m_statsPeriod;
+}
+
+int options::getNbTargets() {
+    return m_objPos.size()/2;
+}
+
+int options::getObjtPos(int target, int i) {
+    return m_objPos[2*target+i];
 }
 
-int options::getObjtSize(int i) {
-    return m_objSize[i];
+int options::getObjtSize(int target, int i) {
+    return m_objSize[2*target+i];
 }
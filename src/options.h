@@ -34,6 +34,7 @@
 #define _TRACKIMG_OPTIONS_H_
 
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -48,11 +49,68 @@ public:
     void setNbProcessors(int arg_value);
     void setVerboseLevel(char* arg_value);
     void setInputDirectory(string arg_value);
+    void setHeadless(bool arg_value);
+    void setPrefetchDepth(int arg_value);
+    void setPrecision(int arg_value);
+    void setLarsSolver(int arg_value);
+    void setProjection(int arg_value);
+    void setSeed(unsigned int arg_value);
+    void setTrajectoryFile(string arg_value);
+    void setInputVideo(string arg_value);
+    void setFramePattern(string arg_value);
+    void setFirstFrame(int arg_value);
+    void setLastFrame(int arg_value);
+    void addTarget(string arg_value);
+    void clearTargets();
+    void setBatch(string arg_value);
+    void setJobs(int arg_value);
+    void setStatsFile(string arg_value);
+    void setStatsPeriod(int arg_value);
+    void setGroundtruth(string arg_value);
+    void setBaseline(string arg_value);
+    void setTolerance(double arg_value);
+    void setCoarseFactor(int arg_value);
+    void setMotionGate(double arg_value);
+    void setFeature(int arg_value);
+    void setUpdate(int arg_value);
+    void setBackgroundUpdate(int arg_value);
+    void setUpdatePeriod(int arg_value);
+    void setScreening(int arg_value);
+    void setScreenKeep(int arg_value);
+    void setWarmStart(bool arg_value);
     int getNbProcessors();
     int getVerboseLevel();
     string getInputDirectory();
-    int getObjtPos(int i);
-    int getObjtSize(int i);
+    bool isHeadless();
+    int getPrefetchDepth();
+    int getPrecision();
+    int getLarsSolver();
+    int getProjection();
+    unsigned int getSeed();
+    string getTrajectoryFile();
+    string getInputVideo();
+    string getFramePattern();
+    int getFirstFrame();
+    int getLastFrame();
+    string getBatch();
+    int getJobs();
+    string getStatsFile();
+    int getStatsPeriod();
+    string getGroundtruth();
+    string getBaseline();
+    double getTolerance();
+    int getCoarseFactor();
+    double getMotionGate();
+    int getFeature();
+    int getUpdate();
+    int getBackgroundUpdate();
+    int getUpdatePeriod();
+    int getScreening();
+    int getScreenKeep();
+    bool isWarmStart();
+    int getNbTargets();
+    int getObjtPos(int target, int i);
+    int getObjtSize(int target, int i);
 
     void print();
 
@@ -60,9 +118,36 @@ private:
     string m_inputDirectory;
     int m_nbProcessors;
     int m_verboseLevel;
+    bool m_headless;
+    int m_prefetchDepth;
+    int m_precision;
+    int m_larsSolver;
+    int m_projection;
+    unsigned int m_seed;
+    string m_trajectoryFile;
+    string m_inputVideo;
+    string m_framePattern;
+    int m_firstFrame;
+    int m_lastFrame;
+    string m_batch;
+    int m_jobs;
+    string m_statsFile;
+    int m_statsPeriod;
+    string m_groundtruth;
+    string m_baseline;
+    double m_tolerance;
+    int m_coarseFactor;
+    double m_motionGate;
+    int m_feature;
+    int m_update;
+    int m_backgroundUpdate;
+    int m_updatePeriod;
+    int m_screening;
+    int m_screenKeep;
+    bool m_warmStart;
 
-    int m_objPos[2];
-    int m_objSize[2];
+    vector<int> m_objPos;   //x, y of every target
+    vector<int> m_objSize;  //w, h of every target
 };
 
 #endif  /* _TRACKIMG_OPTIONS_H_ */
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <chrono>
+
+#include "prefetch.h"
+
+using namespace cv;
+
+frame_prefetcher::frame_prefetcher() : m_slots(0) {
+    m_source = NULL;
+    m_depth = 0;
+    m_next = 0;
+    m_consumed = 0;
+    m_turn = 0;
+    m_end = INT_MAX;
+    m_running = false;
+}
+
+frame_prefetcher::~frame_prefetcher() {
+    stop();
+}
+
+bool frame_prefetcher::read(int index, Mat& frame_c, double& timestamp) {
+    bool ok;
+    if (m_source->isRandomAccess()) {
+        ok = m_source->read(index, frame_c, timestamp);
+    } else {
+        //sequential sources are read by one worker at a time, in index order
+        while (m_turn.load(memory_order_acquire) != index) {
+            if (!m_running) {
+                return false;
+            }
+            this_thread::yield();
+        }
+        ok = m_source->read(index, frame_c, timestamp);
+        m_turn.store(index+1, memory_order_release);
+    }
+    if (!ok) {
+        frame_c.release();
+        return false;
+    }
+    return true;
+}
+
+void frame_prefetcher::start(frame_source* source, int depth) {
+    stop();
+    m_source = source;
+    m_depth = depth;
+    m_next = source->first();
+    m_consumed = source->first();
+    m_turn = source->first();
+    m_end = INT_MAX;
+    if (m_depth <= 0) {
+        return; //synchronous decoding in next()
+    }
+    vector<frame_slot> slots(m_depth);
+    m_slots.swap(slots);
+    for (int i=0; i<m_depth; i++) {
+        m_slots[i].ready = -1;
+    }
+    m_running = true;
+    for (int i=0; i<m_depth; i++) {
+        m_workers.push_back(thread(&frame_prefetcher::run, this));
+    }
+}
+
+void frame_prefetcher::run() {
+    for (;;) {
+        int index = m_next.fetch_add(1);
+        if (index > m_end.load(memory_order_acquire)) {
+            return;
+        }
+        //wait for frame index-depth to be consumed so that its slot is free
+        while (index >= m_consumed.load(memory_order_acquire) + m_depth) {
+            if (!m_running) {
+                return;
+            }
+            this_thread::sleep_for(chrono::microseconds(200));
+        }
+        frame_slot& slot = m_slots[index % m_depth];
+        if (!read(index, slot.frame_c, slot.timestamp)) {
+            //the empty frame published below marks the end for the tracker
+            int end = m_end.load(memory_order_relaxed);
+            while (index < end && !m_end.compare_exchange_weak(end, index)) {
+            }
+        }
+        slot.ready.store(index, memory_order_release);
+    }
+}
+
+bool frame_prefetcher::next(int index, Mat& frame_c, double& timestamp) {
+    if (m_depth <= 0) {
+        return read(index, frame_c, timestamp);
+    }
+    frame_slot& slot = m_slots[index % m_depth];
+    while (slot.ready.load(memory_order_acquire) != index) {
+        this_thread::sleep_for(chrono::microseconds(50));
+    }
+    frame_c = slot.frame_c;
+    timestamp = slot.timestamp;
+    slot.frame_c.release();
+    slot.ready.store(-1, memory_order_relaxed);
+    m_consumed.store(index+1, memory_order_release);
+    return !frame_c.empty();
+}
+
+void frame_prefetcher::stop() {
+    m_running = false;
+    for (size_t i=0; i<m_workers.size(); i++) {
+        m_workers[i].join();
+    }
+    m_workers.clear();
+}
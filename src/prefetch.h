@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_PREFETCH_H_
+#define _TRACKIMG_PREFETCH_H_
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <climits>
+#include "opencv2/core/core.hpp"
+
+#include "source.h"
+
+using namespace std;
+
+/*
+ * Look-ahead decoder for the frames of a frame_source.
+ *
+ * Worker threads decode frames N+1..N+depth while frame N is tracked;
+ * the tracker converts only the regions it reads, see frame_context.
+ * Each frame index owns the slot index%depth of a ring; a slot is
+ * published with an atomic store once the frame is ready and released by
+ * the tracker when it takes the frame, so neither side ever takes a lock.
+ * Sources that are not random access are read in turn, in index order.
+ */
+class frame_prefetcher
+{
+public:
+    frame_prefetcher();
+    ~frame_prefetcher();
+
+    void start(frame_source* source, int depth);
+    bool next(int index, cv::Mat& frame_c, double& timestamp);
+    void stop();
+
+private:
+    struct frame_slot
+    {
+        atomic<int> ready;  //index of the frame held, -1 if none
+        cv::Mat frame_c;
+        double timestamp;
+    };
+
+    void run();
+    bool read(int index, cv::Mat& frame_c, double& timestamp);
+
+    frame_source* m_source;
+    int m_depth;
+
+    vector<frame_slot> m_slots;
+    vector<thread> m_workers;
+    atomic<int> m_next;         //next frame index to decode
+    atomic<int> m_consumed;     //frames before this index are consumed
+    atomic<int> m_turn;         //next frame index a sequential source may read
+    atomic<int> m_end;          //first frame index past the end of the source
+    atomic<bool> m_running;
+};
+
+#endif  /* _TRACKIMG_PREFETCH_H_ */
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <math.h>
+#include <algorithm>
+
+#include "tracker.h"
+#include "projection.h"
+#include "linalg.h"
+
+template<typename _Tp>
+random_projection<_Tp>::random_projection(int mode, int rows, int cols, uint64 seed) :
+    m_mode(mode), m_rows(rows), m_cols(cols), m_scale(1), m_pad(1)
+{
+    RNG rng(seed);
+    if (m_mode == PROJECTION_SPARSE) {
+        //Li et al. very sparse projection: P(+-sqrt(s)) = 1/2s with s = sqrt(cols),
+        //the nonzeros are drawn with geometric gaps instead of one draw per entry
+        double s = std::max(1.0, sqrt((double)m_cols));
+        double lq = log(1 - 1/s);
+        m_scale = (_Tp)sqrt(s);
+        m_start.push_back(0);
+        for (int i=0; i<m_rows; i++) {
+            for (int j=-1; ; ) {
+                j += (s == 1) ? 1 : 1 + (int)floor(log(1 - rng.uniform(0., 1.)) / lq);
+                if (j >= m_cols) {
+                    break;
+                }
+                m_idx.push_back(j);
+                m_sign.push_back(rng.uniform(0, 2) ? 1 : -1);
+            }
+            m_start.push_back((int)m_idx.size());
+        }
+    } else if (m_mode == PROJECTION_SRHT) {
+        while (m_pad < m_cols) {
+            m_pad *= 2;
+        }
+        m_sign.resize(m_cols);
+        for (int j=0; j<m_cols; j++) {
+            m_sign[j] = rng.uniform(0, 2) ? 1 : -1;
+        }
+        //rows drawn without replacement while there are enough of them
+        std::vector<int> perm(m_pad);
+        for (int j=0; j<m_pad; j++) {
+            perm[j] = j;
+        }
+        m_sel.resize(m_rows);
+        for (int i=0; i<m_rows; i++) {
+            int q = i % m_pad;
+            std::swap(perm[q], perm[q + rng.uniform(0, m_pad - q)]);
+            m_sel[i] = perm[q];
+        }
+    } else {
+        m_cm.create(m_rows, m_cols, TRACKIMG_TYPE(_Tp,1));
+        rng.fill(m_cm, RNG::NORMAL, 0, 1);
+    }
+}
+
+template<typename _Tp>
+void random_projection<_Tp>::apply(const Mat& X, Mat& Y) const
+{
+    if (m_mode == PROJECTION_SPARSE) {
+        applySparse(X, Y);
+    } else if (m_mode == PROJECTION_SRHT) {
+        applySrht(X, Y);
+    } else {
+        linalg_gemm<_Tp>(m_cm, X, Y, GEMM_2_T);
+    }
+}
+
+template<typename _Tp>
+void random_projection<_Tp>::applySparse(const Mat& X, Mat& Y) const
+{
+    int k = X.rows;
+    Y.create(m_rows, k, TRACKIMG_TYPE(_Tp,1));
+    for (int a=0; a<k; a++) {
+        const _Tp* x = X.ptr<_Tp>(a);
+        for (int i=0; i<m_rows; i++) {
+            _Tp v = 0;
+            for (int e=m_start[i]; e<m_start[i+1]; e++) {
+                if (m_sign[e] > 0) {
+                    v += x[m_idx[e]];
+                } else {
+                    v -= x[m_idx[e]];
+                }
+            }
+            Y.at<_Tp>(i, a) = m_scale*v;
+        }
+    }
+}
+
+template<typename _Tp>
+void random_projection<_Tp>::applySrht(const Mat& X, Mat& Y) const
+{
+    //unnormalized H*D on each atom; keeping rows of the +-1 transform
+    //gives E||Y||^2 = rows*||X||^2
+    int k = X.rows;
+    Y.create(m_rows, k, TRACKIMG_TYPE(_Tp,1));
+    std::vector<_Tp> w(m_pad);
+    for (int a=0; a<k; a++) {
+        const _Tp* x = X.ptr<_Tp>(a);
+        for (int r=0; r<m_cols; r++) {
+            w[r] = m_sign[r]*x[r];
+        }
+        std::fill(w.begin()+m_cols, w.end(), (_Tp)0);
+        for (int h=1; h<m_pad; h*=2) {
+            for (int r0=0; r0<m_pad; r0+=2*h) {
+                for (int r=r0; r<r0+h; r++) {
+                    _Tp t = w[r];
+                    w[r] = t + w[r+h];
+                    w[r+h] = t - w[r+h];
+                }
+            }
+        }
+        for (int i=0; i<m_rows; i++) {
+            Y.at<_Tp>(i, a) = w[m_sel[i]];
+        }
+    }
+}
+
+template class random_projection<float>;
+template class random_projection<double>;
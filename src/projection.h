@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_PROJECTION_H_
+#define _TRACKIMG_PROJECTION_H_
+
+#include <vector>
+#include "opencv2/core/core.hpp"
+
+using namespace cv;
+
+/* Random projections used to compress the LASSO problems */
+typedef enum {
+    PROJECTION_GAUSSIAN = 0,    /* dense N(0,1) matrix, reference */
+    PROJECTION_SPARSE,          /* very sparse +-sqrt(s) matrix, additions only */
+    PROJECTION_SRHT,            /* subsampled randomized Hadamard transform */
+    PROJECTION_SIZE
+} projection_et;
+
+/*
+ * Random projection of R^cols onto R^rows. Every mode preserves squared
+ * norms in expectation up to the same factor (rows) as the dense Gaussian
+ * matrix, so the LARS stopping error keeps its meaning.
+ *
+ * The matrix is fully determined by the seed; apply() is const and can be
+ * called concurrently.
+ */
+template<typename _Tp>
+class random_projection
+{
+public:
+    random_projection(int mode, int rows, int cols, uint64 seed);
+
+    int rows() const { return m_rows; }
+
+    /**
+     * Y = P*X', with X holding k atoms of size cols, one per row, and
+     * Y of size rows*k.
+     */
+    void apply(const Mat& X, Mat& Y) const;
+
+private:
+    void applySparse(const Mat& X, Mat& Y) const;
+    void applySrht(const Mat& X, Mat& Y) const;
+
+    int m_mode;
+    int m_rows;
+    int m_cols;
+    Mat m_cm;                   //gaussian
+    std::vector<int> m_start;   //sparse, nonzeros of row i in [m_start[i], m_start[i+1])
+    std::vector<int> m_idx;
+    std::vector<signed char> m_sign;   //sparse: signs of the nonzeros, srht: diagonal D
+    _Tp m_scale;                //sparse
+    int m_pad;                  //srht, power of two >= cols
+    std::vector<int> m_sel;     //srht, rows of H*D kept
+};
+
+#endif  /* _TRACKIMG_PROJECTION_H_ */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+
+#include "source.h"
+
+using namespace cv;
+
+directory_source::directory_source(string directory, string pattern, int first, int last) :
+    m_directory(directory), m_pattern(pattern), m_first(first), m_last(last)
+{
+}
+
+bool directory_source::read(int index, Mat& frame_c, double& timestamp)
+{
+    if (m_last >= 0 && index > m_last) {
+        return false;
+    }
+    char name[1024];
+    snprintf(name, sizeof(name), m_pattern.c_str(), index);
+    frame_c = imread(m_directory + "/" + name, CV_LOAD_IMAGE_COLOR);
+    timestamp = (index - m_first) * 1000.0 / TRACKIMG_SEQUENCE_FPS;
+    return !frame_c.empty();
+}
+
+video_source::video_source(string path, int first, int last) :
+    m_capture(path), m_first(first), m_last(last), m_index(0)
+{
+    m_fps = m_capture.get(CV_CAP_PROP_FPS);
+    if (!(m_fps > 0)) {
+        m_fps = TRACKIMG_SEQUENCE_FPS;
+    }
+}
+
+bool video_source::isOpened()
+{
+    return m_capture.isOpened();
+}
+
+bool video_source::read(int index, Mat& frame_c, double& timestamp)
+{
+    if (m_last >= 0 && index > m_last) {
+        return false;
+    }
+    //frames before the requested one are decoded and dropped, a video is read forward only
+    while (m_index < index) {
+        if (!m_capture.read(frame_c)) {
+            frame_c.release();
+            return false;
+        }
+        m_index++;
+    }
+    //position of the frame just read, or the nominal one if the backend has none
+    timestamp = m_capture.get(CV_CAP_PROP_POS_MSEC);
+    if (!(timestamp > 0) && m_index > 1) {
+        timestamp = (m_index - 1) * 1000.0 / m_fps;
+    }
+    return !frame_c.empty();
+}
+
+frame_source* open_frame_source(options opt)
+{
+    if (!opt.getInputVideo().empty()) {
+        video_source* video = new video_source(opt.getInputVideo(), opt.getFirstFrame(), opt.getLastFrame());
+        if (!video->isOpened()) {
+            delete video;
+            return NULL;
+        }
+        return video;
+    }
+    return new directory_source(opt.getInputDirectory(), opt.getFramePattern(), opt.getFirstFrame(), opt.getLastFrame());
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_SOURCE_H_
+#define _TRACKIMG_SOURCE_H_
+
+#include <string>
+#include "opencv2/core/core.hpp"
+#include "opencv2/highgui/highgui.hpp"
+
+#include "options.h"
+
+using namespace std;
+
+/* frame rate assumed for the timestamps of numbered image sequences */
+#define TRACKIMG_SEQUENCE_FPS 30
+
+/*
+ * Input of the tracker, one frame at a time, at constant memory.
+ *
+ * Frames are numbered by the source; the tracker asks for consecutive
+ * indices starting from first(). Only sources that report isRandomAccess()
+ * may be read from several threads at once, the others are read in index
+ * order by one thread at a time.
+ */
+class frame_source
+{
+public:
+    virtual ~frame_source() {}
+
+    virtual int first() = 0;
+    virtual bool isRandomAccess() = 0;
+
+    /**
+     * Read frame <index>, 8-bit BGR as decoded, and its timestamp in msec.
+     * Returns false past the end of the input.
+     */
+    virtual bool read(int index, cv::Mat& frame_c, double& timestamp) = 0;
+};
+
+/*
+ * Numbered images <directory>/<pattern>, pattern being printf-like with
+ * one integer conversion (e.g. "%d.jpg", "img%05d.png"), from first to
+ * last, or until the first missing image if last < 0.
+ */
+class directory_source : public frame_source
+{
+public:
+    directory_source(string directory, string pattern, int first, int last);
+
+    int first() { return m_first; }
+    bool isRandomAccess() { return true; }
+    bool read(int index, cv::Mat& frame_c, double& timestamp);
+
+private:
+    string m_directory;
+    string m_pattern;
+    int m_first;
+    int m_last;
+};
+
+/*
+ * Frames of a video file decoded by cv::VideoCapture, numbered from 1,
+ * from first to last, or until the end of the file if last < 0.
+ */
+class video_source : public frame_source
+{
+public:
+    video_source(string path, int first, int last);
+
+    bool isOpened();
+    int first() { return m_first; }
+    bool isRandomAccess() { return false; }
+    bool read(int index, cv::Mat& frame_c, double& timestamp);
+
+private:
+    cv::VideoCapture m_capture;
+    int m_first;
+    int m_last;
+    int m_index;    //index of the last frame read
+    double m_fps;
+};
+
+/**
+ * Source described by the options: the video file if one is given, the
+ * numbered images of the input directory otherwise. NULL if the input
+ * cannot be opened.
+ */
+frame_source* open_frame_source(options opt);
+
+#endif  /* _TRACKIMG_SOURCE_H_ */
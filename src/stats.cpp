@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+
+#include "stats.h"
+
+#define STATS_SUB_BUCKETS 16    //per power of two, a power of two itself
+#define STATS_SUB_BITS 4
+#define STATS_BUCKETS ((64-STATS_SUB_BITS+1)*STATS_SUB_BUCKETS)
+
+bool stats_enabled = false;
+
+static const char* stage_names[STAGE_SIZE] = {
+    "frame",
+    "two_stage",
+    "windows",
+    "window_norms",
+    "coarse",
+    "screen",
+    "lasso_stage1",
+    "lasso_stage2",
+    "update",
+    "lasso_normalize",
+    "lasso_norms",
+    "lasso_project",
+    "lasso_solve",
+    "lars",
+    "lasso_vote"
+};
+
+struct stage_stats
+{
+    atomic<uint64_t> count;
+    atomic<uint64_t> sum;   //nsec
+    atomic<uint64_t> max;   //nsec
+    atomic<uint64_t> buckets[STATS_BUCKETS];
+};
+
+static stage_stats stages[STAGE_SIZE];
+static mutex write_mutex;
+
+//values below STATS_SUB_BUCKETS have their own bucket, then 16 per power of two
+static int bucket(uint64_t ns) {
+    if (ns < STATS_SUB_BUCKETS) {
+        return (int)ns;
+    }
+    int e = 63 - __builtin_clzll(ns);
+    int sub = (int)(ns >> (e - STATS_SUB_BITS)) & (STATS_SUB_BUCKETS-1);
+    return (e - STATS_SUB_BITS + 1)*STATS_SUB_BUCKETS + sub;
+}
+
+//middle of the values of bucket b
+static double bucket_value(int b) {
+    if (b < STATS_SUB_BUCKETS) {
+        return b;
+    }
+    int e = b/STATS_SUB_BUCKETS + STATS_SUB_BITS - 1;
+    int sub = b%STATS_SUB_BUCKETS;
+    double width = (double)(1ULL << (e - STATS_SUB_BITS));
+    return (STATS_SUB_BUCKETS + sub)*width + width/2;
+}
+
+void stats_enable(bool enable) {
+    stats_enabled = enable;
+}
+
+void stats_record(int stage, double seconds) {
+    stage_stats& s = stages[stage];
+    uint64_t ns = seconds > 0 ? (uint64_t)(seconds*1e9) : 0;
+    s.count.fetch_add(1, memory_order_relaxed);
+    s.sum.fetch_add(ns, memory_order_relaxed);
+    s.buckets[bucket(ns)].fetch_add(1, memory_order_relaxed);
+    uint64_t max = s.max.load(memory_order_relaxed);
+    while (ns > max && !s.max.compare_exchange_weak(max, ns, memory_order_relaxed)) {
+    }
+}
+
+void stats_reset() {
+    for (int i=0; i<STAGE_SIZE; i++) {
+        stages[i].count = 0;
+        stages[i].sum = 0;
+        stages[i].max = 0;
+        for (int b=0; b<STATS_BUCKETS; b++) {
+            stages[i].buckets[b] = 0;
+        }
+    }
+}
+
+//p-quantile of the histogram, in nsec, counts taken from a snapshot
+static double quantile(const uint64_t* counts, uint64_t total, double p, double max) {
+    uint64_t rank = (uint64_t)(p*total + 0.5);
+    rank = rank < 1 ? 1 : rank;
+    uint64_t seen = 0;
+    for (int b=0; b<STATS_BUCKETS; b++) {
+        seen += counts[b];
+        if (seen >= rank) {
+            double v = bucket_value(b);
+            return v < max ? v : max;
+        }
+    }
+    return max;
+}
+
+bool stats_write_json(string path) {
+    lock_guard<mutex> lock(write_mutex);
+    string tmp = path + ".tmp";
+    FILE* file = fopen(tmp.c_str(), "w");
+    if (file == NULL) {
+        return false;
+    }
+    fprintf(file, "{\n  \"unit\": \"msec\",\n  \"stages\": {");
+    static uint64_t counts[STATS_BUCKETS];
+    for (int i=0; i<STAGE_SIZE; i++) {
+        stage_stats& s = stages[i];
+        //the histogram is read while threads may still record, its total is the reference
+        uint64_t total = 0;
+        for (int b=0; b<STATS_BUCKETS; b++) {
+            counts[b] = s.buckets[b].load(memory_order_relaxed);
+            total += counts[b];
+        }
+        double max = (double)s.max.load(memory_order_relaxed);
+        double mean = total > 0 ? (double)s.sum.load(memory_order_relaxed)/total : 0;
+        fprintf(file, "%s\n    \"%s\": { \"count\": %llu, \"mean\": %.6f, \"p50\": %.6f, \"p95\": %.6f, \"p99\": %.6f, \"max\": %.6f }",
+                i ? "," : "", stage_names[i], (unsigned long long)total, mean*1e-6,
+                total ? quantile(counts, total, 0.50, max)*1e-6 : 0,
+                total ? quantile(counts, total, 0.95, max)*1e-6 : 0,
+                total ? quantile(counts, total, 0.99, max)*1e-6 : 0,
+                max*1e-6);
+    }
+    fprintf(file, "\n  }\n}\n");
+    if (fclose(file) != 0) {
+        return false;
+    }
+    return rename(tmp.c_str(), path.c_str()) == 0;
+}
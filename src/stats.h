@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_STATS_H_
+#define _TRACKIMG_STATS_H_
+
+#include <string>
+#include <omp.h>
+
+using namespace std;
+
+/* Instrumented stages of the tracker */
+typedef enum {
+    STAGE_FRAME = 0,        /* one frame of one target */
+    STAGE_TWO_STAGE,        /* Rec_two_stage_sparse */
+    STAGE_WINDOWS,          /* region and sliding windows of the first stage */
+    STAGE_WINDOW_NORMS,     /* norms of the windows and first stage templates */
+    STAGE_COARSE,           /* coarse search of the first stage at reduced resolution */
+    STAGE_SCREEN,           /* screening of the windows of the first stage */
+    STAGE_LASSO_STAGE1,     /* Rec_Lasso of the first stage, detection */
+    STAGE_LASSO_STAGE2,     /* Rec_Lasso of the second stage, verification */
+    STAGE_UPDATE,           /* update of the target after a verified detection */
+    STAGE_LASSO_NORMALIZE,  /* Rec_Lasso: normalization of the templates */
+    STAGE_LASSO_NORMS,      /* Rec_Lasso: norms of the dictionary, when not given */
+    STAGE_LASSO_PROJECT,    /* Rec_Lasso: random projections */
+    STAGE_LASSO_SOLVE,      /* Rec_Lasso: all the solves of a call */
+    STAGE_LARS,             /* one LARS solve */
+    STAGE_LASSO_VOTE,       /* Rec_Lasso: max frequency vote */
+    STAGE_SIZE
+} stage_et;
+
+/*
+ * Runtime latency statistics of the stages.
+ *
+ * Every stage aggregates its durations into a log-linear histogram of
+ * atomic counters (16 buckets per power of two, within 6%), so OpenMP
+ * threads record concurrently without locks and the memory does not
+ * grow with the run. When disabled, a timer costs one test of
+ * stats_enabled.
+ */
+extern bool stats_enabled;
+
+/* to call before the tracking threads start */
+void stats_enable(bool enable);
+void stats_record(int stage, double seconds);
+void stats_reset();
+
+/**
+ * Write count, mean, p50, p95, p99 and max (msec) of every stage as JSON to
+ * <path>, replaced atomically so that a reader never sees a partial file.
+ */
+bool stats_write_json(string path);
+
+/* times the enclosing scope, or up to stop(), as one sample of <stage> */
+class stage_timer
+{
+public:
+    explicit stage_timer(int stage) : m_stage(stage), m_start(stats_enabled ? omp_get_wtime() : -1) {}
+    ~stage_timer() { stop(); }
+
+    void stop() {
+        if (m_start >= 0) {
+            stats_record(m_stage, omp_get_wtime() - m_start);
+            m_start = -1;
+        }
+    }
+
+private:
+    int m_stage;
+    double m_start;
+};
+
+#endif  /* _TRACKIMG_STATS_H_ */
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdio.h>
+#include "opencv2/core/core.hpp"
+
+#include "trackimg.h"
+#include "trace.h"
+#include "target.h"
+#include "feature.h"
+#include "stats.h"
+
+using namespace std;
+using namespace cv;
+
+template<typename _Tp>
+target_tracker<_Tp>::target_tracker(options opt, int id) :
+    m_opt(opt), m_id(id), m_rng(((uint64)opt.getSeed() << 32) + (unsigned int)id)
+{
+    m_nf = 200;
+    m_nff = 100;
+    m_nfn = 400;
+
+    //===========random permutation========//
+    Mat sss (1,100,CV_64F);
+    m_rng.fill(sss, RNG::UNIFORM, 1, 100);
+    //===========samples in Tar used in Lasso for recognition=======//
+    m_sf.create(1,22,CV_64F);
+    m_sf.at<double>(0,0)=1;
+    for (int i2=0; i2<10; i2++)
+    {sss.col(i2).copyTo(m_sf.col(i2+1));}
+    for (int i2=0; i2<11; i2++)
+    {m_sf.at<double>(0,11+i2)=(m_nff+2*i2);}
+    //=========== Scale use for creaf ROI ==============//
+    m_scaT = Mat::ones(2,1,CV_64F);
+    m_scaR = Mat::ones(2,1,CV_64F)*2;
+    m_scaRO = Mat::ones(2,1,CV_64F)*3;
+    m_scaRN = Mat::ones(2,1,CV_64F)*3;
+    // ========== Step of sliding windows ========//
+    m_wbwD=4; //for object segment in ROI (for animal: wbw_d=4 ; wbw_n=10)
+    m_wbhD=4;
+    m_wbwN=10; //for background sample
+    m_wbhN=10;
+    // ========== another parameters =============//
+    m_vg=1;
+    m_cr=30; //(for animal: 30 - 3/4)
+    m_itr=3;
+
+    // ========== error for OMP ============//
+    m_param.err=0.001;
+    m_param.nu=20;
+    m_param.solver=opt.getLarsSolver();
+    m_param.projection=opt.getProjection();
+    m_param.seed=(unsigned int)(opt.getSeed()+id);
+
+    m_tar.flag=0;
+    m_tar.feaFrame=0;
+    m_tar.feaNFrame=0;
+}
+
+template<typename _Tp>
+void target_tracker<_Tp>::init(frame_context<_Tp>& a, Rect box)
+{
+    Mat p(2, 1, CV_64F); //coordinate of selected object - top-left point
+    Mat sz(2, 1, CV_64F); //size of selected object
+    p.at<double>(0,0)=box.x;
+    p.at<double>(1,0)=box.y;
+    sz.at<double>(0,0)=box.width;
+    sz.at<double>(1,0)=box.height;
+
+    Mat aa = a.roi(box); //selected object
+    feature_extractor<_Tp> fx(m_opt.getFeature(), box.height, box.width);
+
+    /*================= Create Tar.fea ========================
+        ================ Tar.fea is a matrix contains: [Tar.fea [Tar.fea + Gausse]]=============
+        ================ with Tar.fea is a selected object =====================================*/
+
+    vector<window_index> idx;
+    Mat Tar_fea1= fx.windows(aa, 1, 1, idx);	//Tar.fea contains selected object in 1 row
+
+    Mat Gau_T(m_nf-1, Tar_fea1.cols, TRACKIMG_TYPE(_Tp,1)); //Gaussien T
+    m_rng.fill(Gau_T, RNG::NORMAL, 0, m_vg*fx.noise());
+
+    Mat Tar_fea(m_nf, Tar_fea1.cols, TRACKIMG_TYPE(_Tp,1));
+    Tar_fea1.copyTo(Tar_fea.row(0));
+    Mat Tar_fea111 = Tar_fea.rowRange(1, m_nf);
+    repeat(Tar_fea1,m_nf-1,1,Tar_fea111); //Tar_fea111 la lap lai 199 lan Tar_fea1 (aa)
+    Tar_fea111 += Gau_T;
+    m_tar.fea.assign(Tar_fea, m_nff-1);   //the first nff-1 templates are kept for the whole sequence
+    /*================= Create Tar.pos ========================
+        ================ Tar.pos is a history contains: [p p p p ... p]=============
+        ================ with p is top-left position vector ============================*/
+
+    Mat Tar_pos;
+    repeat(p.reshape(0, 1), m_nf, 1, Tar_pos);
+    m_tar.pos.assign(Tar_pos, m_nff-1);
+    /*================= Create Tar.siz ========================
+            ================ Tar.siz is a history contains: [sz sz sz.... sz]=============
+            ================ with sz is size of selected object vector ===================*/
+
+    Mat Tar_siz;
+    repeat(sz.reshape(0, 1), m_nf, 1, Tar_siz);
+    m_tar.siz.assign(Tar_siz, m_nff-1);
+    /*================= Create Tar.flag ========================
+            ============ is a flag marks successful regcognition or not =============*/
+    m_tar.flag = 0;
+    /*================= Create Tar.posres ========================*/
+    Mat Tar_posres(Size(p.cols,p.rows+sz.rows),CV_64F);
+    Tar_posres.at<double>(0,0)=p.at<double>(0,0);
+    Tar_posres.at<double>(1,0)=p.at<double>(1,0);
+    Tar_posres.at<double>(2,0)=sz.at<double>(0,0);
+    Tar_posres.at<double>(3,0)=sz.at<double>(1,0);
+    Tar_posres.copyTo(m_tar.posres);
+    /*================= Create Tar.pnew ========================*/
+    //assume that object moves regularly
+    Mat Tar_pnew(2,2,CV_64F);
+    Tar_pnew.col(0)=(m_tar.pos.col(m_nff-1)+m_tar.pos.col(m_nff-1)-m_tar.pos.col(m_nff-2));
+    m_tar.pos.col(m_nff-1).copyTo(Tar_pnew.col(1));
+    Tar_pnew.copyTo(m_tar.pnew);
+    m_motion.init(p);
+
+    /*================= Create Tar.feaN ========================*/
+    Mat Tar_feaN;
+    Tar_feaN=Region_Negative<_Tp>(a, m_wbhN, m_wbwN, m_tar.pos.col(m_nff-1), m_tar.siz.col(m_nff-1), m_scaR, m_rng, m_opt.getFeature());
+    m_tar.feaN.assign(Tar_feaN, 0, m_nfn);  //most recent background atoms only
+    m_tar.feaNSig = background_signature(a.bgr(), m_tar.pos.col(m_nff-1), m_tar.siz.col(m_nff-1), m_scaRN);
+}
+
+template<typename _Tp>
+void target_tracker<_Tp>::track(frame_context<_Tp>& b, int k)
+{
+    stage_timer timer(STAGE_FRAME);
+    Tar_properties& Tar = m_tar;
+
+    //======================== motion model ===========================
+    double gate = m_opt.getMotionGate();
+    Mat pc; //centre of the search, Tar.pnew.col(0) when empty
+    if (gate > 0)
+    {
+        m_motion.predict();
+        pc = m_motion.position();
+    }
+
+    //======================== detect succesfull ======================
+    if (Tar.flag == 0)
+    {
+        print_trackimg_trace(TRACKIMG_VL_VERBOSE_2, "Trackimg : Object %d found\n", m_id);
+        //before run 2nd frame, Tar_flag = 0 bcz initialize in 1st frame = 0
+        Mat ScaR;
+        if (gate > 0)
+        {
+            //region of the predicted uncertainty, never more than the one after a loss
+            Mat step(2, 1, CV_64F);
+            step.at<double>(0,0) = m_wbwD;
+            step.at<double>(1,0) = m_wbhD;
+            ScaR = m_motion.regionScale(Tar.siz.col(m_nff-1), gate, step, m_scaRO);
+        }
+        else
+        {
+            m_scaR.copyTo(ScaR);
+        }
+        Tar = Rec_two_stage_sparse<_Tp>(m_opt, b, Tar, ScaR, m_scaT, m_scaRN, m_param, m_cr, m_itr, m_wbhD, m_wbwD, m_wbhN, m_wbwN, m_sf, k, m_nff, m_rng, pc);
+    }
+
+    Mat balance (Tar.pnew.rows, 1, CV_64F);
+    //========================= detect failed =========================
+    if (Tar.flag != 0)
+    {
+        print_trackimg_trace(TRACKIMG_VL_VERBOSE_1, "Trackimg : Object %d lost\n", m_id);
+        //============= enlarge region for detection =================
+        if (Tar.flag > 1)
+        {
+            print_trackimg_trace(TRACKIMG_VL_VERBOSE_2, "Trackimg : Object %d lost : try to detect in bigger region\n", m_id);
+            //======= try to detect in bigger region =======
+            Mat ScaR;
+            m_scaRO.copyTo(ScaR);
+            Tar = Rec_two_stage_sparse<_Tp>(m_opt, b, Tar, ScaR, m_scaT, m_scaRN, m_param, m_cr, m_itr, m_wbhD, m_wbwD, m_wbhN, m_wbwN, m_sf, k, m_nff, m_rng, pc);
+        }
+        // =========== after detect in enlarge region ===============
+        if (Tar.flag != 0)
+        {
+            print_trackimg_trace(TRACKIMG_VL_VERBOSE_2, "Trackimg : Object %d lost : after detect in enlarge region\n", m_id);
+            //************ Tar_flag = 1
+            if (Tar.pnew.cols < TRACKIMG_PNEW_SIZE)
+            {//============fill balance with 0=========
+                for(int ih=0; ih<balance.rows; ih++)
+                {
+                    balance.at<double>(ih,0) = 0;
+                }
+            }
+            else
+            {//=============calculate balance===========
+                Mat ROI_Tar_pnew_mean_1 = Tar.pnew(Rect(1, 0, 8, Tar.pnew.rows));
+                Mat temp1; ROI_Tar_pnew_mean_1.copyTo(temp1);
+                Mat ROI_Tar_pnew_mean_2 = Tar.pnew(Rect(2, 0, 8, Tar.pnew.rows));
+                Mat temp2; ROI_Tar_pnew_mean_2.copyTo(temp2);
+                Mat sum = temp1 - temp2;
+                reduce(sum, balance, 1, CV_REDUCE_AVG);
+            }
+            //calculate Tar.pnew base on balance and update Tar.pnew
+            Mat Tar_pnew_temp(Tar.pnew.rows, 1, CV_64F);
+            Mat temp1;Tar.pnew.col(0).copyTo(temp1);
+            Mat temp2;Tar.pnew.col(1).copyTo(temp2);
+            Tar_pnew_temp = temp1 - temp2;
+            for(int ii=0; ii<Tar_pnew_temp.rows; ii++)
+            {Tar_pnew_temp.at<double>(ii,0)=cvRound(Tar_pnew_temp.at<double>(ii,0));}
+            Tar_pnew_temp = Tar_pnew_temp*0.3 + Tar.pnew.col(0) + 0.3*balance;
+            //update Tar.pnew, appended after the history so only kept while it is short
+            if (Tar.pnew.cols < TRACKIMG_PNEW_SIZE)
+            {
+                hconcat(Tar.pnew, Tar_pnew_temp, Tar.pnew);
+            }
+
+            Tar.flag = Tar.flag + 1;
+            //the estimated position is the new box
+            Tar.pnew.col(0).copyTo(Tar.posres.rowRange(0, Tar.pnew.rows));
+            Tar.siz.col(m_nff-1).copyTo(Tar.posres.rowRange(Tar.pnew.rows, Tar.posres.rows));
+        }
+    }
+
+    //only the verified detections correct the motion model
+    if ((gate > 0) && (Tar.flag == 0))
+    {
+        m_motion.correct(Tar.pos.col(m_nff-1));
+    }
+}
+
+template<typename _Tp>
+Rect target_tracker<_Tp>::box()
+{
+    return Rect(m_tar.posres.at<double>(0,0), m_tar.posres.at<double>(1,0), m_tar.posres.at<double>(2,0), m_tar.posres.at<double>(3,0));
+}
+
+template<typename _Tp>
+int target_tracker<_Tp>::flag()
+{
+    return m_tar.flag;
+}
+
+template<typename _Tp>
+int target_tracker<_Tp>::id()
+{
+    return m_id;
+}
+
+/* Explicit instantiations */
+template class target_tracker<float>;
+template class target_tracker<double>;
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_TARGET_H_
+#define _TRACKIMG_TARGET_H_
+
+#include "opencv2/core/core.hpp"
+
+#include "options.h"
+#include "tracker.h"
+#include "motion.h"
+
+using namespace cv;
+
+/*
+ * Tracking state and parameters of one target.
+ *
+ * A target only reads the frames it is given, so several targets can track
+ * in the same decoded frame at once. Target <id> seeds its projections with
+ * the seed of the options plus id, target 0 replays a single target run.
+ */
+template<typename _Tp>
+class target_tracker
+{
+public:
+    target_tracker(options opt, int id);
+
+    /**
+     * Build the templates of the object <box> (x, y, w, h) of the first
+     * frame a and its background.
+     */
+    void init(frame_context<_Tp>& a, Rect box);
+
+    /**
+     * Search the target in frame b, the k-th frame after the first one.
+     * When it is lost, its position is extrapolated from the last ones.
+     * With -k, the search region follows the motion filter instead of the
+     * last position and the fixed scales.
+     */
+    void track(frame_context<_Tp>& b, int k);
+
+    Rect box();
+    int flag();
+    int id();
+
+private:
+    options m_opt;
+    int m_id;
+    Tar_properties m_tar;
+    parameter_OMP m_param;
+    motion_filter m_motion; //centre and size of the search region, with -k
+    RNG m_rng;              //templates and background noise, seeded from -s and the id
+
+    int m_nf;   //size of the histories
+    int m_nff;  //newest item of the histories at m_nff-1, the ones before are pinned
+    int m_nfn;  //max number of background atoms in m_tar.feaN
+
+    Mat m_sf;       //templates of m_tar.fea used in Lasso for recognition
+    Mat m_scaT;     //scales of the object
+    Mat m_scaR;     //scales of region for retrieval
+    Mat m_scaRO;    //scales of region for retrieval when occlusion is detected
+    Mat m_scaRN;    //scales of region for background samples
+
+    int m_wbwD;     //steps of sliding windows for object segment in ROI
+    int m_wbhD;
+    int m_wbwN;     //steps of sliding windows for background samples
+    int m_wbhN;
+    int m_vg;       //scale Gaussian noise for initial samples
+    double m_cr;    //Gaussian compression rate in lasso recognition
+    double m_itr;   //iterative times for random compression in lasso recognition
+};
+
+#endif  /* _TRACKIMG_TARGET_H_ */
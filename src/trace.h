@@ -46,8 +46,25 @@ static const char *TRACKIMG_ERRORS_TXT[TRACKIMG_ERR_SIZE] = {
     "Arg value for -n is not valide.",
     "Arg value for -m is not valide.",
     "Arg value for -v is not valide.",
+    "Arg value for -p is not valide.",
+    "Arg value for -f is not valide.",
+    "Arg value for -l is not valide.",
+    "Arg value for -r is not valide.",
+    "Arg value for -g is not valide, one %d conversion expected.",
+    "Arg value for -b is not valide.",
+    "Arg value for -t is not valide, x,y,w,h expected.",
+    "Arg value for -j is not valide.",
+    "Arg value for -P is not valide.",
+    "Arg value for -T is not valide.",
+    "Arg value for -c is not valide.",
+    "Arg value for -k is not valide.",
+    "Arg value for -F is not valide.",
+    "Arg value for -U, -V or -u is not valide.",
+    "Arg value for -R or -K is not valide.",
     "Mandatory argument missing. Please check usage print.",
-    "Cannot open input file."
+    "Cannot open input file.",
+    "Cannot open output file.",
+    "Tracking quality dropped below the baseline."
 };
 
 extern verbose_level_et verbose_level;
@@ -0,0 +1,1101 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * @author Weizhi Liu (MatLab version of the Algorithm)
+ * @author Giang Truong Nguyen (C/C++ version of the Algorithm)
+ *
+ * Maintainers :
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <time.h>
+#include "opencv2/core/core.hpp"
+#include "opencv2/imgproc/imgproc.hpp"
+#include <omp.h>
+
+#include "trackimg.h"
+#include "tracker.h"
+#include "lars.h"
+#include "projection.h"
+#include "linalg.h"
+#include "feature.h"
+#include "stats.h"
+
+using namespace std;
+using namespace cv;
+
+//im_seg_windows
+template<typename _Tp>
+Mat im_seg_windows(Mat A, int h, int w, int wbh, int wbw, vector<window_index>& idx)
+{
+    int z=3; //for color image
+    //number of windows in each direction, A is read in place
+    int y = (A.rows-h+1 > 0) ? (A.rows-h+wbh)/wbh : 0;	//vertical
+    int x = (A.cols-w+1 > 0) ? (A.cols-w+wbw)/wbw : 0;	//horizon
+
+    //one window per contiguous row: [row 0 of the window, row 1, ...], pixels in RGB order
+    Mat D(x*y, h*w*z, TRACKIMG_TYPE(_Tp,1));
+    idx.resize(x*y);
+    size_t rowBytes = w*z*sizeof(_Tp);
+
+    #pragma omp parallel for
+    for (int ii=0; ii<y; ii++)
+    {
+        for (int jj=0; jj<x; jj++)
+        {
+            int atom = ii*x + jj;
+            _Tp* d = D.ptr<_Tp>(atom);
+            for (int r=0; r<h; r++) {
+                memcpy(d + r*w*z, A.ptr<_Tp>(ii*wbh + r) + jj*wbw*z, rowBytes);
+            }
+            idx[atom].i = ii;
+            idx[atom].j = jj;
+            idx[atom].w = w;
+            idx[atom].h = h;
+        }
+    }
+    return D;
+}
+
+//window_norms
+template<typename _Tp>
+Mat window_norms(Mat A, const vector<window_index>& idx, int wbh, int wbw)
+{
+    int z=3; //for color image
+    //summed-area table of the squared samples, the channels side by side
+    Mat S, SQ;
+    integral(A.reshape(1), S, SQ, CV_64F);
+
+    Mat N((int)idx.size(), 1, CV_64F);
+    for (int a=0; a<(int)idx.size(); a++)
+    {
+        int r0 = idx[a].i*wbh, r1 = r0 + idx[a].h;
+        int c0 = idx[a].j*wbw*z, c1 = c0 + idx[a].w*z;
+        double s = SQ.at<double>(r1,c1) - SQ.at<double>(r0,c1) - SQ.at<double>(r1,c0) + SQ.at<double>(r0,c0);
+        N.at<double>(a,0) = sqrt(std::max(s, 0.0));
+    }
+    return N;
+}
+
+//coarse_to_fine_windows
+template<typename _Tp>
+Mat coarse_to_fine_windows(Mat Reg, Mat te, int h, int w, int wbh, int wbw, int factor, double cr, double itr, parameter_OMP param, vector<window_index>& idx, Mat& D_norm)
+{
+    int z=3; //for color image
+    int hc = std::max(1, cvRound((double)h/factor));
+    int wc = std::max(1, cvRound((double)w/factor));
+
+    //region and templates downsampled by factor
+    Mat Reg_c;
+    resize(Reg, Reg_c, Size(std::max(1, cvRound((double)Reg.cols/factor)), std::max(1, cvRound((double)Reg.rows/factor))), 0, 0, INTER_AREA);
+    Mat te_c(te.rows, hc*wc*z, TRACKIMG_TYPE(_Tp,1));
+    for (int i=0; i<te.rows; i++)
+    {
+        Mat t = te.row(i).reshape(z, h);
+        Mat t_c = te_c.row(i).reshape(z, hc);
+        resize(t, t_c, Size(wc, hc), 0, 0, INTER_AREA);
+    }
+
+    //coarse search, windows every wbh*factor, wbw*factor pixels of Reg
+    vector<window_index> idx_c;
+    Mat D_c = im_seg_windows<_Tp>(Reg_c, hc, wc, wbh, wbw, idx_c);
+    if (D_c.rows == 0)
+    {
+        return Mat();
+    }
+    Mat D_c_norm = window_norms<_Tp>(Reg_c, idx_c, wbh, wbw);
+    int pv_c = Rec_Lasso<_Tp>(te_c, D_c, D_c_norm, cr, itr, param);
+    if (pv_c == 999)
+    {
+        return Mat();
+    }
+
+    //fine windows within one coarse step of the coarse detection, aligned on the fine grid of Reg
+    int y0 = idx_c[pv_c].i*wbh*factor;
+    int x0 = idx_c[pv_c].j*wbw*factor;
+    int top = std::max(0, (y0 - wbh*factor)/wbh)*wbh;
+    int left = std::max(0, (x0 - wbw*factor)/wbw)*wbw;
+    int bottom = std::min(Reg.rows, y0 + wbh*factor + h);
+    int right = std::min(Reg.cols, x0 + wbw*factor + w);
+    Mat Reg_n = Reg(Rect(left, top, right-left, bottom-top));
+    Mat D = im_seg_windows<_Tp>(Reg_n, h, w, wbh, wbw, idx);
+    D_norm = window_norms<_Tp>(Reg_n, idx, wbh, wbw);
+    for (size_t a=0; a<idx.size(); a++)
+    {
+        idx[a].i += top/wbh;
+        idx[a].j += left/wbw;
+    }
+    return D;
+}
+
+//screen_windows
+template<typename _Tp>
+vector<int> screen_windows(Mat T, Mat D, Mat& D_norm, int rule, int keep, double nu)
+{
+    int n = D.rows;
+    vector<int> kept;
+    if (D_norm.empty())
+    {
+        D_norm.create(n, 1, CV_64F);
+        for (int j=0; j<n; j++)
+        {
+            D_norm.at<double>(j,0) = norm(D.row(j));
+        }
+    }
+    int nk = (rule == SCREEN_TOPK) ? keep : (int)nu;
+    if (rule == SCREEN_NONE || n <= nk)
+    {
+        for (int j=0; j<n; j++)
+        {
+            kept.push_back(j);
+        }
+        return kept;
+    }
+
+    //cosines of the windows and the templates, as the LASSO sees them before projection
+    Mat Tn(T.rows, T.cols, TRACKIMG_TYPE(_Tp,1));
+    for (int i=0; i<T.rows; i++)
+    {
+        double ti = norm(T.row(i));
+        Mat Tn_i = Tn.row(i);
+        T.row(i).convertTo(Tn_i, Tn.type(), (ti > 0) ? 1/ti : 0);
+    }
+    Mat C;
+    linalg_gemm<_Tp>(D, Tn, C, GEMM_2_T);
+    Mat R(T.rows, n, CV_64F);
+    for (int j=0; j<n; j++)
+    {
+        double nj = D_norm.at<double>(j,0);
+        const _Tp* pc = C.ptr<_Tp>(j);
+        for (int i=0; i<T.rows; i++)
+        {
+            R.at<double>(i,j) = (nj > 0) ? std::abs((double)pc[i])/nj : 0;
+        }
+    }
+
+    vector<bool> keep_j(n, false);
+    vector<double> r(n);
+    if (rule == SCREEN_STRONG)
+    {
+        //strong rule from lmax down to l, the first nu of every template always pass
+        for (int i=0; i<T.rows; i++)
+        {
+            const double* pr = R.ptr<double>(i);
+            r.assign(pr, pr+n);
+            nth_element(r.begin(), r.begin()+(nk-1), r.end(), greater<double>());
+            double l = r[nk-1];
+            double lmax = *max_element(r.begin(), r.begin()+nk);
+            for (int j=0; j<n; j++)
+            {
+                keep_j[j] = keep_j[j] || (pr[j] >= 2*l - lmax);
+            }
+        }
+    }
+    else
+    {
+        //best correlation of every window with a template
+        Mat best;
+        reduce(R, best, 0, CV_REDUCE_MAX, CV_64F);
+        const double* pb = best.ptr<double>(0);
+        r.assign(pb, pb+n);
+        nth_element(r.begin(), r.begin()+(nk-1), r.end(), greater<double>());
+        double l = r[nk-1];
+        //ties at l are taken in window order up to keep
+        int above = 0;
+        for (int j=0; j<n; j++)
+        {
+            above += (pb[j] > l);
+        }
+        int ties = nk - above;
+        for (int j=0; j<n; j++)
+        {
+            keep_j[j] = (pb[j] > l) || ((pb[j] == l) && (ties-- > 0));
+        }
+    }
+    for (int j=0; j<n; j++)
+    {
+        if (keep_j[j])
+        {
+            kept.push_back(j);
+        }
+    }
+    return kept;
+}
+
+//warm_start_atoms
+template<typename _Tp>
+Mat warm_start_atoms(const Tar_properties& Tar, const vector<window_index>& idx, const vector<int>& kept, int rows, Mat p_reg, int wbh, int wbw)
+{
+    //row of the dictionary of every window, by steps in the region
+    map<pair<int,int>, int> at;
+    for (int a=0; a<rows; a++)
+    {
+        const window_index& wi = idx[kept.empty() ? a : kept[a]];
+        at[make_pair(wi.i, wi.j)] = a;
+    }
+    //the regions move with the target, a window of the last frame goes to the nearest step
+    Mat warm(rows, Tar.larsBeta.cols, TRACKIMG_TYPE(_Tp,1), Scalar(0));
+    vector<char> taken(rows, 0);
+    bool found = false;
+    for (int q=0; q<Tar.larsWin.rows; q++)
+    {
+        const double* win = Tar.larsWin.ptr<double>(q);
+        int i = cvRound((win[1] - p_reg.at<double>(1,0))/wbh);
+        int j = cvRound((win[0] - p_reg.at<double>(0,0))/wbw);
+        map<pair<int,int>, int>::const_iterator it = at.find(make_pair(i, j));
+        if ((it == at.end()) || taken[it->second])
+        {
+            continue;
+        }
+        const window_index& wi = idx[kept.empty() ? it->second : kept[it->second]];
+        if ((wi.w == cvRound(win[2])) && (wi.h == cvRound(win[3])))
+        {
+            Mat warm_a = warm.row(it->second);
+            Tar.larsBeta.row(q).copyTo(warm_a);
+            taken[it->second] = 1;
+            found = true;
+        }
+    }
+    if (!found)
+    {
+        warm.release();
+    }
+    return warm;
+}
+
+//warm_start_keep
+void warm_start_keep(Tar_properties& Tar, Mat be, const vector<window_index>& idx, const vector<int>& kept, Mat p_reg, int wbh, int wbw)
+{
+    vector<int> nz;
+    for (int a=0; a<be.rows; a++)
+    {
+        if (countNonZero(be.row(a)) > 0)
+        {
+            nz.push_back(a);
+        }
+    }
+    Tar.larsWin.create((int)nz.size(), 4, CV_64F);
+    Tar.larsBeta.create((int)nz.size(), be.cols, be.type());
+    for (size_t q=0; q<nz.size(); q++)
+    {
+        const window_index& wi = idx[kept.empty() ? nz[q] : kept[nz[q]]];
+        double* win = Tar.larsWin.ptr<double>((int)q);
+        win[0] = p_reg.at<double>(0,0) + wi.j*wbw;
+        win[1] = p_reg.at<double>(1,0) + wi.i*wbh;
+        win[2] = wi.w;
+        win[3] = wi.h;
+        Mat beta_q = Tar.larsBeta.row((int)q);
+        be.row(nz[q]).copyTo(beta_q);
+    }
+}
+
+//Region_rect
+Rect Region_rect(Mat A, Mat pt, Mat st, Mat sc)	//return new area of image A
+{
+    int m=A.rows;
+    int n=A.cols;
+    int z=3;
+    Mat pc=pt+0.5*st;			//central of selected object
+    pc.at<double>(0,0)=cvCeil(pc.at<double>(0,0));	//round to nearest integer
+    pc.at<double>(1,0)=cvCeil(pc.at<double>(1,0));
+    pc.convertTo(pc,CV_64F);
+    Mat s=st.mul(sc);			//selected object*scale
+    s.at<double>(0,0)=cvCeil(s.at<double>(0,0));	//round to nearest integer
+    s.at<double>(1,0)=cvCeil(s.at<double>(1,0));
+    s.convertTo(s,CV_64F);
+
+    //calculate top-left position and bottom-right position of new area
+    Mat pl=(pc-0.5*s);
+    pl.at<double>(0,0)=cvCeil(pl.at<double>(0,0));
+    pl.at<double>(1,0)=cvCeil(pl.at<double>(1,0));
+    Mat M1(2,1,CV_64F);
+    M1.at<double>(0,0)=1;
+    M1.at<double>(1,0)=1;
+    pl=pl+M1;
+    Mat pr=(pc+0.5*s);
+    pr.at<double>(0,0)=cvFloor(pr.at<double>(0,0));
+    pr.at<double>(1,0)=cvFloor(pr.at<double>(1,0));
+    pr=pr-M1;
+    //modify pl and pr to openCV coordinate (-1 for each coordinate)
+    pl=pl-M1;
+    pr=pr-M1;
+    if(pl.at<double>(0,0) <= 0 )
+    {pl.at<double>(0,0) = 0;}
+    if(pl.at<double>(1,0) <= 0 )
+    {pl.at<double>(1,0) = 0;}
+
+    //set limit if result calculate is bigger than image
+    if (pr.at<double>(0,0) > n-1)
+    {pr.at<double>(0,0)=n-1;}
+    if (pr.at<double>(1,0) > m-1)
+    {pr.at<double>(1,0)=m-1;}
+
+    return Rect(pl.at<double>(0,0) ,pl.at<double>(1,0) ,pr.at<double>(0,0)-pl.at<double>(0,0) +1 ,pr.at<double>(1,0)-pl.at<double>(1,0)+1);
+}
+
+//Region_seg
+Mat Region_seg(Mat A, Mat pt, Mat st, Mat sc, Mat& p_reg)	//return new area from image A
+{
+    Rect r = Region_rect(A, pt, st, sc);
+    //update new top left position of region
+    p_reg.create(2, 1, CV_64F);
+    p_reg.at<double>(0,0) = r.x;
+    p_reg.at<double>(1,0) = r.y;
+    //Copy new region from A to R
+    Mat R;
+    A(r).copyTo(R);
+    return R;	//return new region
+}
+
+//Region_seg
+template<typename _Tp>
+Mat Region_seg(frame_context<_Tp>& A, Mat pt, Mat st, Mat sc, Mat& p_reg)	//return new area from frame A, as a view
+{
+    Rect r = Region_rect(A.bgr(), pt, st, sc);
+    //update new top left position of region
+    p_reg.create(2, 1, CV_64F);
+    p_reg.at<double>(0,0) = r.x;
+    p_reg.at<double>(1,0) = r.y;
+    return A.roi(r);
+}
+
+//Region_Negative
+template<typename _Tp>
+Mat Region_Negative(frame_context<_Tp>& A, int wbh, int wbw, Mat p, Mat sz, Mat sr, RNG& rng, int feature)
+{
+    //calculate new ROI, that possibility to contain object, only this part of A is copied
+    Mat p_reg;
+    Mat Reg=Region_seg(A,p,sz,sr,p_reg).clone();
+
+    //hide the object with noise
+    Rect box(p.at<double>(0,0)-p_reg.at<double>(0,0) ,p.at<double>(1,0)-p_reg.at<double>(1,0) ,sz.at<double>(0,0)-1 ,sz.at<double>(1,0)-1);
+    Mat sub = Reg(box & Rect(0, 0, Reg.cols, Reg.rows));
+    rng.fill(sub, RNG::NORMAL, 0, 122);
+
+    vector<window_index> idx;
+    feature_extractor<_Tp> fx(feature, sz.at<double>(1,0), sz.at<double>(0,0));
+    Mat FeaN=fx.windows(Reg, wbh, wbw, idx);
+
+    return FeaN;
+}
+
+//background_signature
+Mat background_signature(Mat A, Mat p, Mat sz, Mat sr)
+{
+    Mat sig;
+    resize(A(Region_rect(A, p, sz, sr)), sig, Size(TRACKIMG_UPDATE_SIGNATURE, TRACKIMG_UPDATE_SIGNATURE), 0, 0, INTER_AREA);
+    return sig;
+}
+
+Mat hist(Mat data, Mat nbins)
+{
+    //frequency of each element of nbins in data
+    //input data and nbins is rows vetor
+    Mat result(1, nbins.cols, CV_64F);
+    int freq=0;
+    for (int jc=0; jc<nbins.cols; jc++)	//each element of nbins
+    {
+        for (int ic=0; ic<data.cols; ic++)	//each element of data
+        {
+            if(nbins.at<double>(0,jc) == data.at<double>(0,ic))
+            {
+                freq++;
+            }
+        }
+        result.at<double>(0,jc) = freq;
+        freq = 0;
+    }
+    return result;
+}	
+
+Mat find_element_equal_less_zero(Mat scr)
+{
+    vector<double> sign;
+    int ind=0;
+    for(int ic=0; ic<scr.cols; ic++)
+    {
+        for (int jh=0; jh<scr.rows; jh++)
+        {
+            if (scr.at<double>(jh,ic) <= 0)
+            {sign.push_back(ind);}
+            ind++;
+        }
+    }
+    Mat sign_return(1, sign.size(), CV_64F);
+    for (int f=0;f<sign.size();f++)
+    {
+        sign_return.at<double>(0,f) = sign[f];
+    }
+    transpose(sign_return, sign_return);
+    return sign_return;
+}
+
+Mat setdiff(Mat scr1, Mat scr2)
+{
+    //find an element in scr1 that different with element in scr 2 (scr 2 is an Scalar)
+    for(int ic=0; ic<scr2.cols; ic++)
+    {
+        for (int jc=0; jc<scr1.cols; jc++)
+        {
+            if(scr2.at<double>(0,ic) == scr1.at<double>(0,jc))
+            {
+                scr1.at<double>(0,jc) = -1;
+            }
+        }
+    }
+    vector<double> result;
+    for (int ic=0; ic<scr1.cols; ic++)
+    {
+        if(scr1.at<double>(0,ic) != -1)
+        {
+            result.push_back(scr1.at<double>(0,ic));
+        }
+    }
+    Mat result1(1, result.size(), CV_64F);
+    for(int ic=0; ic<result.size(); ic++)
+    {
+        result1.at<double>(0,ic) = result[ic];
+    }
+    return result1;
+}
+
+template<typename _Tp>
+Mat sign_element_matrix(Mat source, Mat position)
+{
+    //input is a column matrix for source and line matrix for position - return a colum matrix
+    double temp;
+    vector<double> sign;
+    for (int ic=0; ic<position.cols; ic++)
+    {
+        temp = source.at<_Tp>(position.at<double>(0,ic), 0);
+        if (temp > 0)
+        {sign.push_back(1);}
+        else if (temp == 0)
+        {sign.push_back(0);}
+        else
+        {sign.push_back(-1);}
+    }
+
+    Mat sign_return1(sign.size(), 1, TRACKIMG_TYPE(_Tp,1));
+    for (int jh=0; jh<sign_return1.rows; jh++)
+    {
+        sign_return1.at<_Tp>(jh,0) = sign[jh];
+    }
+
+    return sign_return1;
+}
+
+template<typename _Tp>
+Mat lars_lu(Mat y, Mat X, double err, double nu)
+{
+    //Dicitionary X, vector y,  nu is sparsity. Return vector coefficient
+    /*================================================ LARS ALGORITHMS ==========================================*/
+
+    int m=X.rows;
+    int n=X.cols;
+    Mat yr;
+    //initialization for residual
+    y.copyTo(yr);
+    //S contains index of atoms in dictionary X
+    Mat S(1, n, CV_64F);
+    for (int h=0; h<n; h++)
+    {
+        S.at<double>(0,h)=h;
+    }
+    //initialize coefficient beta = 0
+    Mat beta(n, 1, TRACKIMG_TYPE(_Tp,1), Scalar(0));
+    //project yr to dictionary X
+    int i=0;
+    Mat X_transpose;
+    transpose(X,X_transpose);
+    Mat c=X_transpose*yr;
+    Mat c_a = abs(c);
+    //find max coefficient
+    double minVal;
+    double c_m;
+    Point minLoc;
+    Point maxLoc;
+    minMaxLoc(c_a, &minVal, &c_m, &minLoc, &maxLoc);
+
+    //find location of max coefficients (index of atom that have max projection)
+    int ind=0;
+    vector<double> Sa_array;
+    for (int jh=0; jh<c_a.rows; jh++)
+    {
+        if(c_a.at<_Tp>(jh,0)==c_m)
+        {
+            Sa_array.push_back(ind);
+        }
+        ind++;
+    }
+
+    Mat Sa (1, Sa_array.size(), CV_64F);
+    for (int h=0;h<Sa_array.size();h++)
+    {
+        Sa.at<double>(0,h)=Sa_array[h];
+    }
+
+    /*================================ WHILE LOOP ============================ */
+    while(i<=nu && norm(yr)>err)
+    {
+        i++;
+        Mat sign_c_Sa = sign_element_matrix<_Tp>(c, Sa); //sign(c(Sa))
+        transpose(sign_c_Sa, sign_c_Sa);	//sign(c(Sa))'
+        repeat(sign_c_Sa, m,1, sign_c_Sa);	//repmat(sign(c(Sa))',m,1)
+        Mat X_temp(X.rows, Sa.cols, TRACKIMG_TYPE(_Tp,1));
+        for(int h=0; h < Sa.cols; h++)
+        {X.col(Sa.at<double>(0,h)).copyTo(X_temp.col(h));}		//X(:,Sa)
+        Mat Xa = sign_c_Sa.mul(X_temp);		//repmat(sign(c(Sa))',m,1).*X(:,Sa)
+        Mat Xa_tranpose;
+        transpose(Xa, Xa_tranpose);
+        Mat C_1= Xa_tranpose*yr;
+        double C = C_1.at<_Tp>(0,0);
+
+        Mat Ga_temp=Mat::eye(Xa.cols, Xa.cols, TRACKIMG_TYPE(_Tp,1));
+        Mat Ga = Xa_tranpose*Xa + 0.00000001*Ga_temp;
+        Mat one_1 = Mat::ones(Sa.cols , 1, TRACKIMG_TYPE(_Tp,1));
+        Mat one_1_transpose;
+        transpose(one_1, one_1_transpose);
+        Mat Ga_inverse1; Mat Ga_inverse;
+        Ga.convertTo(Ga_inverse1, CV_64F); //invert in double whatever _Tp is
+        Ga_inverse=Ga_inverse1.inv();
+        Ga_inverse.convertTo(Ga_inverse, TRACKIMG_TYPE(_Tp,1));
+        Mat Aa = (one_1_transpose * Ga_inverse * one_1);
+        pow(Aa, -0.5, Aa);		//we can use in this case bcs Aa is sure a Scalar -- what is that mean ^(-1/2) in matrix calculation?
+        double Aa_scalar = Aa.at<_Tp>(0,0);
+        Mat Wa=Aa_scalar * Ga_inverse * one_1;
+        Mat Ua = Xa * Wa;
+
+        /*============ LOOP EXIT WHEN SEARCHING REACH TO THE END ELEMENT OF DICTIONARY =============*/
+        if (i==n)
+        {
+            Mat yr_transpose;
+            transpose(yr, yr_transpose);
+            Mat r_h;
+            r_h=yr_transpose*Ua;
+            double r_h_Scalar = r_h.at<_Tp>(0,0);	//to avoid error at line .mul after
+            sign_c_Sa = sign_element_matrix<_Tp>(c, Sa);
+
+            Mat beta_increament = (r_h_Scalar*sign_c_Sa).mul(Wa);
+            vector<double> beta_increment_vector;
+            for(int ic=0; ic<beta_increament.rows; ic++)
+            {beta_increment_vector.push_back(beta_increament.at<_Tp>(ic,0));}
+
+            for (int h=0; h<Sa.cols; h++)
+            {
+                beta.at<_Tp>(Sa.at<double>(0,h) ,0) = beta.at<_Tp>(Sa.at<double>(0,h) ,0) + beta_increment_vector[h];
+            }
+            yr = y-X*beta;
+            return beta;
+        }
+        /*===========================================================================================*/
+
+        Mat a;
+        a = X_transpose*Ua;
+        Mat Sc = setdiff(S, Sa);	//Sc is unactive set
+
+        /*========================= NOT REACH THE END ELEMENT OF DICTIONARY YET, SO, FIND AMOUNT TO UPDATE BETA (AMOUNT IS u(gamma) AND UPDATE BETA ============================*/
+        /*=========================== we do and update coefficient beta with the formular: u(gamma) = uA + AMOUNT*Ua = uA + AMOUNT*(Xa*Wa) ==================================== */
+
+        // ============ calculate set of gamma ======================= //
+        vector<double> Sr_vector;
+        for (int j=0; j<Sc.cols; j++)
+        {
+            double v1 = (C - c.at<_Tp>(Sc.at<double>(0,j), 0)) / (Aa_scalar - a.at<_Tp>(Sc.at<double>(0,j), 0));
+            double v2 = (C + c.at<_Tp>(Sc.at<double>(0,j), 0)) / (Aa_scalar + a.at<_Tp>(Sc.at<double>(0,j), 0));
+            Sr_vector.push_back(v1);
+            Sr_vector.push_back(v2);
+        }
+        Mat Sr(1, Sr_vector.size(), CV_64F);	//tranfer set of gamma to matrix type
+        for (int h=0;h<Sr_vector.size();h++)
+        {Sr.at<double>(0,h)=Sr_vector[h];}
+        //========== find min posistive value in set of gamma ========//
+        Mat ne = find_element_equal_less_zero(Sr); //negative element is set to be inf
+        for (int h=0; h<ne.rows; h++)
+        {
+            Sr.at<double>(0, ne.at<double>(h,0)) = numeric_limits<double>::infinity();
+        }
+        double r_h;
+        double maxVal;
+        minMaxLoc(Sr, &r_h, &maxVal, &minLoc, &maxLoc);
+        r_h = double(r_h);
+        double p_h;
+        p_h = minLoc.x;	//Sr is a row matrix
+        p_h = cvFloor(p_h/2);
+        //=========== increase coefficiennt beta(Sa) in the direction of sign of its corellation with y (corellation with y is X'*y)==========//
+        sign_c_Sa = sign_element_matrix<_Tp>(c, Sa);
+        Mat beta_increament = (r_h*sign_c_Sa).mul(Wa);
+        vector<double> beta_increment_vector;
+        for(int ic=0; ic<beta_increament.rows; ic++)
+        {
+            beta_increment_vector.push_back(beta_increament.at<_Tp>(ic,0));
+        }
+
+        for (int h=0; h<Sa.cols; h++)
+        {
+            beta.at<_Tp>(int(Sa.at<double>(0,h)) ,0) = beta.at<_Tp>(int(Sa.at<double>(0,h)) ,0) + beta_increment_vector[h];
+        }
+        // =========== calculate residual yr , update vector of current correlation c and update active set Sa ======= //
+        yr = y - X*beta;
+        c= X_transpose * yr;
+        //update active set
+        transpose(Sa, Sa);
+        Sa.resize(Sa.rows + 1);
+        Sa.at<double>(Sa.rows-1, 0) = Sc.at<double>(0, p_h);
+        transpose(Sa, Sa);
+    }
+
+    return beta;
+}
+
+template<typename _Tp>
+lasso_projection Rec_Lasso_project(Mat T, Mat D, Mat D_norm, double cr, uint64 seed, parameter_OMP param)
+{
+    int m=D.cols;
+    int cp;
+    cp=cvRound(m/cr);		//cr must different 1 to active the random projection matrix, if cr=1 => don't use random projection and we can set it = 0
+
+    //own RNG stream, theRNG() is shared by all the repetitions
+    random_projection<_Tp> cm(param.projection, cp, m, seed);
+
+    lasso_projection pr;
+    cm.apply(T, pr.tec);
+    cm.apply(D, pr.Dc);
+    //P*(D/norm)' = (P*D')*diag(1/norm), a zero atom stays zero as with divide()
+    for (int j=0; j<pr.Dc.cols; j++)
+    {
+        double nj = D_norm.at<double>(j,0);
+        Mat Dc_j = pr.Dc.col(j);
+        Dc_j *= (nj > 0) ? 1/nj : 0;
+    }
+    if (param.solver == LARS_SOLVER_GRAM && lars_gram_pays_off(pr.Dc.cols, T.rows, param.nu)) {
+        linalg_gemm<_Tp>(pr.Dc, pr.Dc, pr.G, GEMM_1_T);
+        linalg_gemm<_Tp>(pr.Dc, pr.tec, pr.B, GEMM_1_T);
+    }
+    return pr;
+}
+
+template<typename _Tp>
+Mat Rec_Lasso_solve(const lasso_projection& pr, int j, parameter_OMP param, Mat beta0)
+{
+    stage_timer timer(STAGE_LARS);
+    if (!pr.G.empty()) {
+        Mat tj = pr.tec.col(j);
+        return lars_gram<_Tp>(pr.G, pr.B.col(j), tj.dot(tj), param.err, param.nu, beta0);
+    }
+    if (param.solver == LARS_SOLVER_REFERENCE) {
+        return lars_lu<_Tp>(pr.tec.col(j), pr.Dc, param.err, param.nu);
+    }
+    return lars_chol<_Tp>(pr.tec.col(j), pr.Dc, param.err, param.nu, beta0);
+}
+
+template<typename _Tp>
+int Rec_Lasso(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param )
+{
+    Mat be;
+    return Rec_Lasso<_Tp>(T, D, D_norm, cr, itr, param, Mat(), be);
+}
+
+template<typename _Tp>
+int Rec_Lasso(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param, Mat warm, Mat& be)
+{
+    int flg;		//flg is always an integer ?
+
+    //atoms are rows of T and D
+    stage_timer normalize_timer(STAGE_LASSO_NORMALIZE);
+    Mat T_temp;
+    pow(T,2,T_temp);
+    reduce(T_temp, T_temp, 1, CV_REDUCE_SUM, TRACKIMG_TYPE(_Tp,1));
+
+    for (int i=0; i<T_temp.rows; i++)
+    {
+        T_temp.at<_Tp>(i,0)=sqrt(T_temp.at<_Tp>(i,0));
+    }
+    repeat(T_temp, 1, T.cols, T_temp);
+    divide(T, T_temp, T);
+    normalize_timer.stop();
+
+    //D is left untouched, its atoms are normalized after projection
+    if (D_norm.empty())
+    {
+        stage_timer norms_timer(STAGE_LASSO_NORMS);
+        D_norm.create(D.rows, 1, CV_64F);
+        for (int i=0; i<D.rows; i++)
+        {
+            D_norm.at<double>(i,0)=norm(D.row(i));
+        }
+    }
+    int n=D.rows;
+
+    int nrep=(int)itr;
+    int itx=T.rows;
+    vector<lasso_projection> pr(nrep);
+    uint64 seed=param.seed;
+
+    //one random projection per repetition
+    stage_timer project_timer(STAGE_LASSO_PROJECT);
+    #pragma omp parallel for schedule(dynamic)
+    for (int r=0; r<nrep; r++)
+    {
+        pr[r] = Rec_Lasso_project<_Tp>(T, D, D_norm, cr, seed+r, param);
+    }
+    project_timer.stop();
+
+    //every (repetition, template) solve is an independent task writing its own column of be
+    stage_timer solve_timer(STAGE_LASSO_SOLVE);
+    be.create(n, nrep*itx, TRACKIMG_TYPE(_Tp,1));
+    bool warmed = (warm.rows == n) && (warm.cols == nrep*itx);
+    #pragma omp parallel for schedule(dynamic,1)
+    for (int t=0; t<nrep*itx; t++)
+    {
+        Mat be_t = be.col(t);
+        Rec_Lasso_solve<_Tp>(pr[t/itx], t%itx, param, warmed ? warm.col(t) : Mat()).copyTo(be_t);
+    }
+    solve_timer.stop();
+
+    /*=======================================max frequency========================================*/
+    stage_timer vote_timer(STAGE_LASSO_VOTE);
+    Mat mvm;
+    //	double SEUIL = -1.0;
+    reduce(be, mvm, 0, CV_REDUCE_MAX, TRACKIMG_TYPE(_Tp,1));//find mvm is maximum of each column of be
+    Mat pvm_temp(be.rows, 1, TRACKIMG_TYPE(_Tp,1));//to store each column of be to find index of mvm
+    Mat pvm(1, be.cols, CV_64F);//find pvm is indexs of each mvm in each column
+    int h=0;
+    for (h=0; h<mvm.cols; h++)
+    {
+        be.col(h).copyTo(pvm_temp);//take each column of be
+        double minVal_be, maxVal_be;
+        Point minLoc_be, maxLoc_be;
+        minMaxLoc(pvm_temp, &minVal_be, &maxVal_be, &minLoc_be, &maxLoc_be);
+        //			if (maxVal_be<SEUIL) {pvm.at<double>(0,h) = mvm.cols;}
+        //			else
+        {pvm.at<double>(0,h) = maxLoc_be.y;}//index of mvm is index of max element of current column
+    }
+
+    Mat up(1, be.rows+1, CV_64F);	//contains index of atom in Dictionary, begin from 0
+    for (int h=0; h<up.cols; h++)
+    {
+        up.at<double>(0,h) = h;
+    }
+
+    Mat ph=hist(pvm,up);//ph is a row vector
+    //find max value mvv of ph and index of max value pvv in ph
+    double minVal_ph, mvv;
+    Point minLoc_ph, maxLoc_ph;
+    minMaxLoc(ph, &minVal_ph, &mvv, &minLoc_ph, &maxLoc_ph);
+    int pvv = maxLoc_ph.x;
+    double pv=up.at<double>(0,pvv);
+    if (maxLoc_ph.x==mvm.cols) {
+        pv=n;
+    }
+    /*===========================================================================================*/
+    if (pv <= n-1)	// n can equal 0
+    {
+        flg=pv;
+    } else {
+        flg=999;
+    }
+
+    return flg;
+}
+
+template<typename _Tp>
+Tar_properties Rec_two_stage_sparse(options opt, frame_context<_Tp>& b, Tar_properties Tar, Mat ScaR, Mat Sca_T, Mat Sca_R_N, parameter_OMP param, double cr, double itr, int wbh_d, int wbw_d, int wbh_n, int wbw_n, Mat sf, int k, int nff, RNG& rng, Mat pc)
+{
+    stage_timer timer(STAGE_TWO_STAGE);
+    string pathToData = opt.getInputDirectory() + "/output/";
+    string extension = ".jpg";
+    string index = to_string(k);
+    pathToData = pathToData + index + extension;
+    /*============This function is to detect object and then further verify it===========*/
+    //		%%%%%%%%%%%%%%%% FIRST STAGE DETECT THE TARGET %%%%%%%%%%%%%%%%%%%%%%
+    /*=== Calculate the new region that possibility to have an object ===*/
+    stage_timer windows_timer(STAGE_WINDOWS);
+    Mat p_reg;  //top-left point of Reg in b
+    Mat Reg = Region_seg(b,  pc.empty() ? Tar.pnew.col(0) : pc,  Tar.siz.col(nff-1),  ScaR, p_reg);
+    Mat sz;
+    Mat D;                      //sliding windows, one atom per row
+    Mat D_norm;                 //norms of the windows of D
+    vector<window_index> D_idx; //index and size of each window of D
+
+    //candidate objects in region for reitrival
+    Mat te(sf.cols, Tar.fea.cols(), TRACKIMG_TYPE(_Tp,1));
+    for (int i=0; i<sf.cols; i++)
+    {Tar.fea.row(sf.at<double>(0,i)-1).copyTo(te.row(i));}
+
+    //distinct projection streams for every frame, stage and repetition
+    param.seed = (param.seed << 32) + (uint64)(2*k)*(int)itr;
+
+    /*=================== Get Dictationary (D) that contains data of sliding windows in various size ==========*/
+    for (int ir=0; ir < Sca_T.cols; ir++)
+    {
+        //Sca_T is contains various scale to change size, in this program, it just have 1 scale
+        //==== change size of selected object with scale ==========//
+        sz = Sca_T.col(ir).mul(Tar.siz.col(nff-1));
+        //round all elements of sz
+        for(int ih=0; ih<sz.rows; ih++)
+        {for (int jc=0; jc<sz.cols; jc++)
+            {sz.at<double>(ih,jc)=cvRound(sz.at<double>(ih,jc));}}
+        double h = sz.at<double>(1,0);
+        double w = sz.at<double>(0,0);
+        //==========================================================//
+        //this loop just execut 1 time, the last scale gives the dictionary
+        D.release();
+        if ((opt.getCoarseFactor() > 1) && (opt.getFeature() == FEATURE_PIXELS))
+        {
+            //only the windows around a detection in the downsampled region, on its own projection streams
+            parameter_OMP param_c = param;
+            param_c.seed += 1ULL << 31;
+            stage_timer coarse_timer(STAGE_COARSE);
+            D=coarse_to_fine_windows<_Tp>(Reg,te,h,w,wbh_d,wbw_d,opt.getCoarseFactor(),cr,itr,param_c,D_idx,D_norm);
+        }
+        if (D.rows == 0)
+        {
+            //every window of the region, also when the coarse search found nothing
+            feature_extractor<_Tp> fx(opt.getFeature(), h, w);
+            D=fx.windows(Reg,wbh_d,wbw_d,D_idx); //sliding windows
+            D_norm.release();
+        }
+    }
+    windows_timer.stop();
+
+    //all the windows come from Reg, their norms from one summed-area table,
+    //Rec_Lasso takes the ones of the other features from the atoms
+    stage_timer norms_timer(STAGE_WINDOW_NORMS);
+    if (D_norm.empty() && (opt.getFeature() == FEATURE_PIXELS))
+    {
+        D_norm = window_norms<_Tp>(Reg, D_idx, wbh_d, wbw_d);
+    }
+    norms_timer.stop();
+
+    //only the windows that can win go to the projections and the solver
+    stage_timer screen_timer(STAGE_SCREEN);
+    Mat Ds = D;
+    Mat Ds_norm = D_norm;
+    vector<int> D_kept; //rows of D in Ds, empty when Ds is D
+    if (opt.getScreening() != SCREEN_NONE)
+    {
+        D_kept = screen_windows<_Tp>(te, D, D_norm, opt.getScreening(), opt.getScreenKeep(), param.nu);
+        if ((int)D_kept.size() < D.rows)
+        {
+            Ds.create((int)D_kept.size(), D.cols, D.type());
+            Ds_norm.create((int)D_kept.size(), 1, CV_64F);
+            for (size_t a=0; a<D_kept.size(); a++)
+            {
+                D.row(D_kept[a]).copyTo(Ds.row(a));
+                Ds_norm.at<double>(a,0) = D_norm.at<double>(D_kept[a],0);
+            }
+        }
+        else
+        {
+            D_kept.clear();
+            Ds_norm = D_norm;
+        }
+    }
+    screen_timer.stop();
+
+    stage_timer stage1_timer(STAGE_LASSO_STAGE1);
+    Mat warm;   //solves of the last frame on the windows at the same place
+    Mat be;
+    if (opt.isWarmStart() && !Tar.larsWin.empty())
+    {
+        warm = warm_start_atoms<_Tp>(Tar, D_idx, D_kept, Ds.rows, p_reg, wbh_d, wbw_d);
+    }
+    int pv=Rec_Lasso<_Tp>(te, Ds, Ds_norm, cr, itr, param, warm, be);
+    if (opt.isWarmStart())
+    {
+        warm_start_keep(Tar, be, D_idx, D_kept, p_reg, wbh_d, wbw_d);
+    }
+    if ((pv != 999) && !D_kept.empty())
+    {
+        pv = D_kept[pv];
+    }
+    stage1_timer.stop();
+
+    //		%%%%%%%%%%%%%%%% Second stage further verify recognition results%%%%%%%%%%%%%%%%%%%%%%
+    if(pv!=999)	//object detected in 1st stage
+    {
+        Mat t2;
+        D.row(pv).copyTo(t2); //use detect result of 1st stage to be a target of 2nd stage
+        /*============== creat new dictionary D2 to verify result in 1st stage ====================*/
+        /*======D2 contains 2 parts: 1st part is Tar.fea contains target in 1st row and target+noise in rest=========*/
+        /*========================== 2nd part is Tar.feaN contains background after hide target ========================*/
+        /*====== so,if the result of verifying process is in the 1st part of dictionary => object verified ========*/
+        /*=== else,if the result of verifying process is in the 2nd part of dictionary => object is a part of background ======*/
+        /*====== only the part an atom belongs to matters, so both histories are taken in storage order ======*/
+        Mat D2;
+        vconcat(Tar.fea.view(), Tar.feaN.view(), D2);
+
+        param.seed += (int)itr;
+        stage_timer stage2_timer(STAGE_LASSO_STAGE2);
+        int pv2 = Rec_Lasso<_Tp>(t2, D2, Mat(), cr, itr, param); //run detect in 2nd stage
+        stage2_timer.stop();
+        if((pv2>=0) & (pv2<=(Tar.fea.size()-1)))
+        {
+            //********* target is verified in the 1st part of dictionary => detection result of 1st stage is correct **************
+            stage_timer update_timer(STAGE_UPDATE);
+            Mat pij(2,1,CV_64F);	//take index of windows in row pv (result detection of first stage)
+            pij.at<double>(0,0) = D_idx[pv].i;
+            pij.at<double>(1,0) = D_idx[pv].j;
+            Mat sz2(2,1,CV_64F);
+            sz2.at<double>(0,0) = D_idx[pv].w;
+            sz2.at<double>(1,0) = D_idx[pv].h;
+            Mat pt;
+            p_reg.copyTo(pt);
+            //take windows pv in frame b. top_left point is in pt and index of windows in pij
+            double top_left_col = pt.at<double>(0,0) + (pij.at<double>(1,0))*wbw_d;
+            double top_left_row = pt.at<double>(1,0) + (pij.at<double>(0,0))*wbh_d;
+            double size_col = sz2.at<double>(0,0);
+            double size_row = sz2.at<double>(1,0);
+
+            Mat ppp(4,1,CV_64F);
+            ppp.at<double>(0,0) = top_left_col + 1;//why + 1?
+            ppp.at<double>(1,0) = top_left_row + 1;
+            ppp.at<double>(2,0) = sz2.at<double>(0,0);
+            ppp.at<double>(3,0) = sz2.at<double>(1,0);
+
+            //Update Tar.pos - new positon update, history items nff-1.. age by one
+            Tar.pos.pushFront(ppp.rowRange(0, 2).reshape(0, 1));
+            //Update Tar.pnew - unreliable position
+            Mat pnew(2, std::min(Tar.pnew.cols+1, TRACKIMG_PNEW_SIZE), CV_64F);
+            ppp.rowRange(0, 2).copyTo(pnew.col(0));
+            Tar.pnew.colRange(0, pnew.cols-1).copyTo(pnew.colRange(1, pnew.cols));
+            Tar.pnew = pnew;
+            //Update Tar.siz - new size update
+            Tar.siz.pushFront(ppp.rowRange(2, 4).reshape(0, 1));
+            //Update Tar.fea - first part of dictionary D2 update = [object  object+Noise]
+            bool feaDue = (opt.getUpdate() == UPDATE_ALWAYS);
+            if (opt.getUpdate() == UPDATE_PERIOD)
+            {
+                feaDue = (k - Tar.feaFrame >= opt.getUpdatePeriod());
+            }
+            else if (opt.getUpdate() == UPDATE_CHANGE)
+            {
+                //the newest template no longer describes the verified object
+                Mat newest = Tar.fea.row(nff-1);
+                double c = D.row(pv).dot(newest) / (norm(D.row(pv))*norm(newest) + 1e-12);
+                feaDue = (c < TRACKIMG_UPDATE_SIMILARITY);
+            }
+            if (feaDue)
+            {
+                Mat bbb;
+                D.row(pv).copyTo(bbb);
+                Mat Tar_fea_temp(10, Tar.fea.cols(), TRACKIMG_TYPE(_Tp,1));
+                bbb.row(0).copyTo(Tar_fea_temp.row(0));
+                repeat(bbb, 9, 1, bbb);
+                Mat Gauss(9, bbb.cols, TRACKIMG_TYPE(_Tp,1));
+                feature_extractor<_Tp> fx(opt.getFeature(), D_idx[pv].h, D_idx[pv].w);
+                rng.fill(Gauss, RNG::NORMAL, 0, fx.noise()); //mean=0 and stdvv=1 ?
+                bbb = Gauss + bbb;
+                Mat ROI_Tar_fea_temp = Tar_fea_temp.rowRange(1, 10);
+                bbb.copyTo(ROI_Tar_fea_temp);
+                Tar.fea.pushFront(Tar_fea_temp);    //new templates at nff-1..nff+8, the 10 oldest are dropped
+                Tar.feaFrame = k;
+            }
+
+            Tar.flag = 0; //successful label
+
+            //Update Tar.feaN - 2nd part of dictionary D2 update = background
+            bool feaNDue = (opt.getBackgroundUpdate() == UPDATE_ALWAYS);
+            Mat sig;
+            if (opt.getBackgroundUpdate() == UPDATE_PERIOD)
+            {
+                feaNDue = (k - Tar.feaNFrame >= opt.getUpdatePeriod());
+            }
+            else if (opt.getBackgroundUpdate() == UPDATE_CHANGE)
+            {
+                //the background moved or changed since the last samples
+                sig = background_signature(b.bgr(), Tar.pos.col(nff-1), Tar.siz.col(nff-1), Sca_R_N);
+                feaNDue = Tar.feaNSig.empty()
+                    || (norm(sig, Tar.feaNSig, NORM_L1)/(sig.total()*sig.channels()*255.0) > TRACKIMG_UPDATE_DRIFT);
+            }
+            if (feaNDue)
+            {
+                Mat VV = Region_Negative<_Tp>(b, wbh_n, wbw_n, Tar.pos.col(nff-1), Tar.siz.col(nff-1), Sca_R_N, rng, opt.getFeature());
+                Tar.feaN.pushBack(VV);  //the oldest background atoms are dropped past the capacity
+                Tar.feaNFrame = k;
+                if (!sig.empty())
+                {
+                    Tar.feaNSig = sig;
+                }
+            }
+            //ppp is the new Tar_posres, start() displays and logs it
+            ppp.copyTo(Tar.posres);
+        }
+        else //*************** target is verified in the 2nd part of dictionary => detection result of 1st stage is incorrect **************
+        {
+            Tar.flag = Tar.flag +1;
+        } //enlarge region
+    }
+    else //*************** target is not detected in 1st stage **************
+    {
+        Tar.flag = Tar.flag +1;
+    }//enlarge region
+
+
+    return Tar;
+}
+
+/* Explicit instantiations of the tracker core */
+template Mat im_seg_windows<float>(Mat A, int h, int w, int wbh, int wbw, vector<window_index>& idx);
+template Mat im_seg_windows<double>(Mat A, int h, int w, int wbh, int wbw, vector<window_index>& idx);
+template Mat Region_seg<float>(frame_context<float>& A, Mat pt, Mat st, Mat sc, Mat& p_reg);
+template Mat Region_seg<double>(frame_context<double>& A, Mat pt, Mat st, Mat sc, Mat& p_reg);
+template Mat Region_Negative<float>(frame_context<float>& A, int wbh, int wbw, Mat p, Mat sz, Mat sr, RNG& rng, int feature);
+template Mat Region_Negative<double>(frame_context<double>& A, int wbh, int wbw, Mat p, Mat sz, Mat sr, RNG& rng, int feature);
+template Mat lars_lu<float>(Mat y, Mat X, double err, double nu);
+template Mat lars_lu<double>(Mat y, Mat X, double err, double nu);
+template lasso_projection Rec_Lasso_project<float>(Mat T, Mat D, Mat D_norm, double cr, uint64 seed, parameter_OMP param);
+template lasso_projection Rec_Lasso_project<double>(Mat T, Mat D, Mat D_norm, double cr, uint64 seed, parameter_OMP param);
+template Mat Rec_Lasso_solve<float>(const lasso_projection& pr, int j, parameter_OMP param, Mat beta0);
+template Mat Rec_Lasso_solve<double>(const lasso_projection& pr, int j, parameter_OMP param, Mat beta0);
+template int Rec_Lasso<float>(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param );
+template int Rec_Lasso<double>(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param );
+template int Rec_Lasso<float>(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param, Mat warm, Mat& be);
+template int Rec_Lasso<double>(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param, Mat warm, Mat& be);
+template vector<int> screen_windows<float>(Mat T, Mat D, Mat& D_norm, int rule, int keep, double nu);
+template vector<int> screen_windows<double>(Mat T, Mat D, Mat& D_norm, int rule, int keep, double nu);
+template Mat warm_start_atoms<float>(const Tar_properties& Tar, const vector<window_index>& idx, const vector<int>& kept, int rows, Mat p_reg, int wbh, int wbw);
+template Mat warm_start_atoms<double>(const Tar_properties& Tar, const vector<window_index>& idx, const vector<int>& kept, int rows, Mat p_reg, int wbh, int wbw);
+template Mat window_norms<float>(Mat A, const vector<window_index>& idx, int wbh, int wbw);
+template Mat window_norms<double>(Mat A, const vector<window_index>& idx, int wbh, int wbw);
+template Mat coarse_to_fine_windows<float>(Mat Reg, Mat te, int h, int w, int wbh, int wbw, int factor, double cr, double itr, parameter_OMP param, vector<window_index>& idx, Mat& D_norm);
+template Mat coarse_to_fine_windows<double>(Mat Reg, Mat te, int h, int w, int wbh, int wbw, int factor, double cr, double itr, parameter_OMP param, vector<window_index>& idx, Mat& D_norm);
+template Tar_properties Rec_two_stage_sparse<float>(options opt, frame_context<float>& b, Tar_properties Tar, Mat ScaR, Mat Sca_T, Mat Sca_R_N, parameter_OMP param, double cr, double itr, int wbh_d, int wbw_d, int wbh_n, int wbw_n, Mat sf, int k, int nff, RNG& rng, Mat pc);
+template Tar_properties Rec_two_stage_sparse<double>(options opt, frame_context<double>& b, Tar_properties Tar, Mat ScaR, Mat Sca_T, Mat Sca_R_N, parameter_OMP param, double cr, double itr, int wbh_d, int wbw_d, int wbh_n, int wbw_n, Mat sf, int k, int nff, RNG& rng, Mat pc);
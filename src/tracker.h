@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ *
+ * @author Weizhi Liu (MatLab version of the Algorithm)
+ * @author Giang Truong Nguyen (C/C++ version of the Algorithm)
+ *
+ * Maintainers :
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+#ifndef _TRACKIMG_TRACKER_H_
+#define _TRACKIMG_TRACKER_H_
+
+#include <vector>
+#include "opencv2/core/core.hpp"
+
+#include "options.h"
+#include "history.h"
+#include "frame.h"
+
+using namespace cv;
+
+/*
+ * The tracker core is templated on the scalar type _Tp (float or double)
+ * of frames, features, dictionaries and solver. Positions and sizes stay
+ * in double. Both types are instantiated in tracker.cpp.
+ */
+
+/* OpenCV type of a _Tp matrix with cn channels */
+#define TRACKIMG_TYPE(_Tp, cn) CV_MAKETYPE(DataType<_Tp>::depth, cn)
+
+/* columns of Tar.pnew read by the motion extrapolation, older ones are dropped */
+#define TRACKIMG_PNEW_SIZE 10
+
+/* When the templates and the background atoms are updated after a verified detection */
+typedef enum {
+    UPDATE_ALWAYS = 0,  /* every verified detection, reference */
+    UPDATE_PERIOD,      /* every options::getUpdatePeriod() frames */
+    UPDATE_CHANGE,      /* when the model no longer matches, see below */
+    UPDATE_SIZE
+} update_et;
+
+/* Screening of the windows of the first stage before the LASSO */
+typedef enum {
+    SCREEN_NONE = 0,    /* every window, reference */
+    SCREEN_STRONG,      /* strong rule on the correlations with the templates */
+    SCREEN_TOPK,        /* the options::getScreenKeep() most correlated windows */
+    SCREEN_SIZE
+} screen_et;
+
+/* UPDATE_CHANGE of Tar.fea: cosine of the detection and the newest template below */
+#define TRACKIMG_UPDATE_SIMILARITY 0.98
+/* UPDATE_CHANGE of Tar.feaN: mean absolute change of the background signature above, in 0..1 */
+#define TRACKIMG_UPDATE_DRIFT 0.04
+/* side of the background signature, in samples */
+#define TRACKIMG_UPDATE_SIGNATURE 8
+
+struct Tar_properties
+{
+    history_ring fea;   //target templates, one atom per row
+    history_ring pos;   //top-left positions (x, y), newest at nff-1
+    history_ring siz;   //sizes (w, h), newest at nff-1
+    Mat posres;         //current box (x, y, w, h)
+    Mat pnew;           //positions for the next search, newest first, at most TRACKIMG_PNEW_SIZE
+    history_ring feaN;  //background templates, one atom per row
+    int flag;
+    int feaFrame;       //frame of the last update of fea
+    int feaNFrame;      //frame of the last update of feaN
+    Mat feaNSig;        //background signature at the last update of feaN
+    Mat larsWin;        //with -w, windows (x, y, w, h) in the frame of the atoms of larsBeta
+    Mat larsBeta;       //with -w, their coefficients in the first stage solves of the last frame
+} ;
+
+struct parameter_OMP
+{
+    double err;
+    double nu;
+    int solver;     //lars_solver_et
+    int projection; //projection_et
+    uint64 seed;    //first seed of the projection streams of a Rec_Lasso call
+};
+
+/* one random projection of the templates and of the dictionary */
+struct lasso_projection
+{
+    Mat tec;    //projected templates
+    Mat Dc;     //projected dictionary
+    Mat G;      //Dc'*Dc, empty when the Gram solver is not used
+    Mat B;      //Dc'*tec
+};
+
+struct step_windows
+{
+    int d;
+    int n;
+};
+
+/* position of a sliding window in its region, in steps, and its size */
+struct window_index
+{
+    int i;  //vertical step
+    int j;  //horizontal step
+    int w;
+    int h;
+};
+
+/**
+ * All the h*w windows of A taken every wbh rows and wbw columns, one
+ * window per row of the returned matrix, with their steps and size in idx.
+ */
+template<typename _Tp>
+Mat im_seg_windows(Mat A, int h, int w, int wbh, int wbw, vector<window_index>& idx);
+
+/**
+ * Norms of the windows of im_seg_windows(A, ...) from an integral image
+ * of the squared pixels of A, in O(1) per window.
+ */
+template<typename _Tp>
+Mat window_norms(Mat A, const vector<window_index>& idx, int wbh, int wbw);
+
+/**
+ * Windows of the first stage found coarse to fine: Rec_Lasso runs on Reg
+ * and te downsampled by factor, then only the h*w windows of Reg within
+ * one coarse step of the coarse detection are returned, with their steps
+ * relative to Reg in idx and their norms in D_norm. Returns an empty Mat
+ * when the coarse search finds nothing, for the caller to search all of
+ * Reg.
+ */
+template<typename _Tp>
+Mat coarse_to_fine_windows(Mat Reg, Mat te, int h, int w, int wbh, int wbw, int factor, double cr, double itr, parameter_OMP param, vector<window_index>& idx, Mat& D_norm);
+
+/**
+ * Rows of D (windows) kept by the screening rule (screen_et) for the
+ * templates T, in increasing order. The correlations are the cosines of
+ * the windows and the templates; with SCREEN_STRONG, a window is kept
+ * when its correlation with a template reaches 2*l - lmax, l being the
+ * nu-th largest and lmax the largest correlation of that template. With
+ * SCREEN_TOPK, the keep windows of largest correlation with any template
+ * are kept. D_norm holds the norms of the windows, computed here when
+ * empty.
+ */
+template<typename _Tp>
+vector<int> screen_windows(Mat T, Mat D, Mat& D_norm, int rule, int keep, double nu);
+
+/**
+ * Warm start of the first stage: the coefficients of Tar.larsBeta moved
+ * to the rows of the windows idx of the region at p_reg (steps wbh, wbw)
+ * nearest to their place in the frame. kept maps the rows of the
+ * dictionary to idx when the windows were screened, rows is its size.
+ * Empty when no window is found again.
+ */
+template<typename _Tp>
+Mat warm_start_atoms(const Tar_properties& Tar, const vector<window_index>& idx, const vector<int>& kept, int rows, Mat p_reg, int wbh, int wbw);
+
+/* keep the windows of the nonzero coefficients of be in Tar for the next warm start */
+void warm_start_keep(Tar_properties& Tar, Mat be, const vector<window_index>& idx, const vector<int>& kept, Mat p_reg, int wbh, int wbw);
+
+/**
+ * Region of A around the box (pt, st) scaled by sc, clipped to A, and its
+ * top-left point in p_reg.
+ */
+Mat Region_seg(Mat A, Mat pt, Mat st, Mat sc, Mat& p_reg);
+
+/* rectangle of A that Region_seg(A, pt, st, sc, ...) copies */
+Rect Region_rect(Mat A, Mat pt, Mat st, Mat sc);
+
+/**
+ * As Region_seg, on a frame converted on demand: the region is a view
+ * shared with the other regions of the frame, not to be written.
+ */
+template<typename _Tp>
+Mat Region_seg(frame_context<_Tp>& A, Mat pt, Mat st, Mat sc, Mat& p_reg);
+
+/**
+ * Coarse signature of the region of the 8-bit frame A that
+ * Region_Negative(..., p, sz, sr) samples, to tell when the background
+ * drifted.
+ */
+Mat background_signature(Mat A, Mat p, Mat sz, Mat sr);
+
+/**
+ * Background atoms of A: the windows of the object size around the box
+ * (p, sz) scaled by sr, with the object hidden by noise drawn from rng,
+ * as features of type feature (feature_et).
+ */
+template<typename _Tp>
+Mat Region_Negative(frame_context<_Tp>& A, int wbh, int wbw, Mat p, Mat sz, Mat sr, RNG& rng, int feature = 0);
+
+template<typename _Tp>
+Mat lars_lu(Mat y, Mat X, double err, double nu);
+
+template<typename _Tp>
+lasso_projection Rec_Lasso_project(Mat T, Mat D, Mat D_norm, double cr, uint64 seed, parameter_OMP param);
+
+/* beta0 warm starts the LARS solvers but the reference one, see lars_chol */
+template<typename _Tp>
+Mat Rec_Lasso_solve(const lasso_projection& pr, int j, parameter_OMP param, Mat beta0 = Mat());
+
+/**
+ * D_norm holds the norms of the atoms of D (n*1, CV_64F), or is empty to
+ * compute them here.
+ */
+template<typename _Tp>
+int Rec_Lasso(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param );
+
+/**
+ * As above, the solves warm started from the columns of warm (n rows,
+ * one column per repetition and template, in the order of be) unless it
+ * is empty, and their coefficients returned in be.
+ */
+template<typename _Tp>
+int Rec_Lasso(Mat T, Mat D, Mat D_norm, double cr, double itr, parameter_OMP param, Mat warm, Mat& be);
+
+/**
+ * One detection and verification of the target in frame b. The projections
+ * are seeded from param.seed, which tells targets apart, and the frame k,
+ * the noise of the updated templates and background drawn from rng, the
+ * target's own stream. The search region is centred on the box at pc, Tar.pnew.col(0) if empty.
+ */
+template<typename _Tp>
+Tar_properties Rec_two_stage_sparse(options opt, frame_context<_Tp>& b, Tar_properties Tar, Mat ScaR, Mat Sca_T, Mat Sca_R_N, parameter_OMP param, double cr, double itr, int wbh_d, int wbw_d, int wbh_n, int wbw_n, Mat sf, int k, int nff, RNG& rng, Mat pc = Mat());
+
+#endif  /* _TRACKIMG_TRACKER_H_ */
@@ -40,8 +40,25 @@ typedef enum {
     TRACKIMG_ERR_BAD_ARGS_NBPROC,
     TRACKIMG_ERR_BAD_ARGS_MS,
     TRACKIMG_ERR_BAD_ARGS_VERBOSE,
+    TRACKIMG_ERR_BAD_ARGS_PREFETCH,
+    TRACKIMG_ERR_BAD_ARGS_PRECISION,
+    TRACKIMG_ERR_BAD_ARGS_SOLVER,
+    TRACKIMG_ERR_BAD_ARGS_PROJECTION,
+    TRACKIMG_ERR_BAD_ARGS_PATTERN,
+    TRACKIMG_ERR_BAD_ARGS_RANGE,
+    TRACKIMG_ERR_BAD_ARGS_TARGET,
+    TRACKIMG_ERR_BAD_ARGS_JOBS,
+    TRACKIMG_ERR_BAD_ARGS_STATS,
+    TRACKIMG_ERR_BAD_ARGS_TOLERANCE,
+    TRACKIMG_ERR_BAD_ARGS_COARSE,
+    TRACKIMG_ERR_BAD_ARGS_MOTION,
+    TRACKIMG_ERR_BAD_ARGS_FEATURE,
+    TRACKIMG_ERR_BAD_ARGS_UPDATE,
+    TRACKIMG_ERR_BAD_ARGS_SCREEN,
     TRACKIMG_ERR_MANDATORY_ARGS,
     TRACKIMG_ERR_DEF_INPUT,
+    TRACKIMG_ERR_DEF_OUTPUT,
+    TRACKIMG_ERR_REGRESSION,
     TRACKIMG_ERR_SIZE /* only used for string tab declaration */
 } trackimgmap_error_et;
 
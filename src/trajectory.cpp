@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#include <stdint.h>
+
+#include "trajectory.h"
+
+trajectory_sink::trajectory_sink() :
+    m_file(NULL), m_format(TRAJECTORY_CSV)
+{
+}
+
+trajectory_sink::~trajectory_sink()
+{
+    close();
+}
+
+bool trajectory_sink::open(string path)
+{
+    close();
+    string ext = ".bin";
+    bool binary = path.size() >= ext.size() && path.compare(path.size()-ext.size(), ext.size(), ext) == 0;
+    m_format = binary ? TRAJECTORY_BINARY : TRAJECTORY_CSV;
+    m_file = fopen(path.c_str(), binary ? "wb" : "w");
+    if (m_file == NULL) {
+        return false;
+    }
+    if (m_format == TRAJECTORY_BINARY) {
+        fwrite("TRJ3", 1, 4, m_file);
+    } else {
+        fprintf(m_file, "frame,target,timestamp,x,y,w,h,flag,msec\n");
+    }
+    return true;
+}
+
+void trajectory_sink::write(int frame, int target, double timestamp, double x, double y, double w, double h, int flag, double msec)
+{
+    if (m_file == NULL) {
+        return;
+    }
+    if (m_format == TRAJECTORY_BINARY) {
+        int32_t ids[3] = { frame, target, flag };
+        double vals[6] = { timestamp, x, y, w, h, msec };
+        fwrite(ids, sizeof(int32_t), 3, m_file);
+        fwrite(vals, sizeof(double), 6, m_file);
+    } else {
+        fprintf(m_file, "%d,%d,%.3f,%g,%g,%g,%g,%d,%.3f\n", frame, target, timestamp, x, y, w, h, flag, msec);
+    }
+}
+
+void trajectory_sink::close()
+{
+    if (m_file != NULL) {
+        fclose(m_file);
+        m_file = NULL;
+    }
+}
+
+bool trajectory_sink::isOpen()
+{
+    return m_file != NULL;
+}
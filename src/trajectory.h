@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2014, INSA of Rennes
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   * Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   * Neither the name of INSA Rennes nor the names of its
+ *     contributors may be used to endorse or promote products derived from this
+ *     software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF
+ * SUCH DAMAGE.
+ *
+ * @author Alexandre Sanchez <alexandre.sanchez@insa-rennes.fr>
+ *
+ */
+
+#ifndef _TRACKIMG_TRAJECTORY_H_
+#define _TRACKIMG_TRAJECTORY_H_
+
+#include <stdio.h>
+#include <string>
+
+using namespace std;
+
+/* Trajectory file formats */
+typedef enum {
+    TRAJECTORY_CSV = 0,     /* one "frame,target,timestamp,x,y,w,h,flag,msec" line */
+    TRAJECTORY_BINARY,      /* "TRJ3" then one fixed-size record */
+    TRAJECTORY_SIZE
+} trajectory_format_et;
+
+/*
+ * Streams the result of every frame and target to a file as soon as it is
+ * known, so the tracker itself only keeps the current boxes whatever the
+ * length of the sequence. A sink that is not opened ignores the frames.
+ *
+ * Binary records are, in native byte order:
+ *   int32 frame, int32 target, int32 flag, double timestamp, x, y, w, h, double msec
+ *
+ * The timestamp is the position of the frame in the input in msec, msec
+ * the time spent tracking the target in it.
+ */
+class trajectory_sink
+{
+public:
+    trajectory_sink();
+    ~trajectory_sink();
+
+    /**
+     * Open <path> for writing, binary if it ends with ".bin", CSV otherwise.
+     */
+    bool open(string path);
+    void write(int frame, int target, double timestamp, double x, double y, double w, double h, int flag, double msec);
+    void close();
+
+    bool isOpen();
+
+private:
+    FILE* m_file;
+    int m_format;
+};
+
+#endif  /* _TRACKIMG_TRAJECTORY_H_ */